@@ -0,0 +1,62 @@
+#ifndef ARQUIVO_MAPEADO_H
+#define ARQUIVO_MAPEADO_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ARQUIVO MAPEADO EM MEMÓRIA (SOMENTE LEITURA)
+//
+// Mapeia o arquivo inteiro com MAP_SHARED: as páginas vêm do page cache,
+// sem cópia, e são compartilhadas entre processos que abrem o mesmo arquivo.
+// O mapeamento é desfeito no destrutor. Arquivos vazios não são mapeados
+// (dados == nullptr, tamanho == 0).
+
+class ArquivoMapeado {
+	public:
+	    explicit ArquivoMapeado(const std::string& caminho) {
+	        const int descritor = ::open(caminho.c_str(), O_RDONLY);
+	        if (descritor < 0) {
+	            throw std::runtime_error("Impossivel abrir o arquivo: " + caminho);
+	        }
+	        
+	        struct stat info;
+	        if (::fstat(descritor, &info) != 0) {
+	            ::close(descritor);
+	            throw std::runtime_error("Impossivel ler o arquivo: " + caminho);
+	        }
+	        
+	        tamanho = static_cast<std::size_t>(info.st_size);
+	        if (tamanho > 0) {
+	            void* endereco = ::mmap(nullptr, tamanho, PROT_READ, MAP_SHARED, descritor, 0);
+	            if (endereco == MAP_FAILED) {
+	                ::close(descritor);
+	                throw std::runtime_error("Falha ao mapear o arquivo: " + caminho);
+	            }
+	            dados = static_cast<const char*>(endereco);
+	        }
+	        ::close(descritor);
+	    }
+	    
+	    ~ArquivoMapeado() {
+	        if (dados) ::munmap(const_cast<char*>(dados), tamanho);
+	    }
+	    
+	    ArquivoMapeado(const ArquivoMapeado&) = delete;
+	    ArquivoMapeado& operator=(const ArquivoMapeado&) = delete;
+	    
+	    // Leitura de ponta a ponta (CSV): o kernel antecipa as próximas páginas
+	    void leituraSequencial() const {
+	        if (dados) ::madvise(const_cast<char*>(dados), tamanho, MADV_SEQUENTIAL);
+	    }
+	    
+	    const char* dados = nullptr;
+	    std::size_t tamanho = 0;
+};
+
+#endif // ARQUIVO_MAPEADO_H
@@ -0,0 +1,133 @@
+#include "Solver.h"
+#include "EspacoTrabalho.h"
+#include "Paralelismo.h"
+#include <atomic>
+#include <limits>
+
+// RESOLUÇÃO EM LOTE
+
+bool interpretarAlgoritmo(std::string_view nome, Algoritmo& algoritmo) {
+    if (nome == "guloso") algoritmo = Algoritmo::Guloso;
+    else if (nome == "guloso-bl") algoritmo = Algoritmo::GulosoBuscaLocal;
+    else if (nome == "dp") algoritmo = Algoritmo::ProgramacaoDinamica;
+    else if (nome == "dp-esparsa") algoritmo = Algoritmo::ProgramacaoDinamicaEsparsa;
+    else if (nome == "bb") algoritmo = Algoritmo::BranchAndBound;
+    else if (nome == "grasp") algoritmo = Algoritmo::GRASP;
+    else if (nome == "auto") algoritmo = Algoritmo::Automatico;
+    else return false;
+    return true;
+}
+
+const char* nomeAlgoritmo(Algoritmo algoritmo) {
+    switch (algoritmo) {
+        case Algoritmo::GulosoBuscaLocal: return "guloso-bl";
+        case Algoritmo::ProgramacaoDinamica: return "dp";
+        case Algoritmo::ProgramacaoDinamicaEsparsa: return "dp-esparsa";
+        case Algoritmo::BranchAndBound: return "bb";
+        case Algoritmo::GRASP: return "grasp";
+        case Algoritmo::Automatico: return "auto";
+        case Algoritmo::Guloso:
+        default: return "guloso";
+    }
+}
+
+ResultadoSolucao OrienteeringProblemSolver::resolver(Algoritmo algoritmo, const ParametrosViagem& params,
+                                                     const OpcoesDP& opcoesDP) {
+    switch (algoritmo) {
+        case Algoritmo::GulosoBuscaLocal:
+            return resolverGulosoComBuscaLocal(params);
+        case Algoritmo::ProgramacaoDinamica:
+            return resolverProgramacaoDinamica(params, opcoesDP);
+        case Algoritmo::ProgramacaoDinamicaEsparsa:
+            return resolverProgramacaoDinamicaEsparsa(params);
+        case Algoritmo::BranchAndBound:
+            return resolverBranchAndBound(params);
+        case Algoritmo::GRASP: {
+            // O lote já ocupa os núcleos com consultas
+            OpcoesGRASP opcoes;
+            opcoes.numThreads = 1;
+            return resolverGRASP(params, opcoes);
+        }
+        case Algoritmo::Automatico: {
+            SLAConsulta sla;
+            sla.opcoesDP = opcoesDP;
+            return resolver(params, sla);
+        }
+        case Algoritmo::Guloso:
+        default:
+            return resolverGuloso(params);
+    }
+}
+
+bool OrienteeringProblemSolver::suportaAlgoritmo(Algoritmo algoritmo) const {
+    switch (algoritmo) {
+        case Algoritmo::ProgramacaoDinamicaEsparsa:
+        case Algoritmo::BranchAndBound:
+        case Algoritmo::GRASP:
+            return !modoHorario();
+        default:
+            return true;
+    }
+}
+
+std::vector<ResultadoSolucao> OrienteeringProblemSolver::resolverLote(
+    const std::vector<ParametrosViagem>& consultas,
+    Algoritmo algoritmo,
+    int numThreads,
+    const OpcoesDP& opcoesDP)
+{
+    validarDados();
+    
+    const int total = static_cast<int>(consultas.size());
+    std::vector<ResultadoSolucao> resultados(total);
+    
+    if (total == 0) {
+        return resultados;
+    }
+    
+    // Consultas distribuídas dinamicamente: DPs e gulosos têm custos muito
+    // diferentes, então blocos fixos desbalanceariam as threads
+    constexpr int TAMANHO_BLOCO = 16;
+    std::atomic<int> proximo(0);
+    
+    numThreads = std::min(resolverNumeroThreads(numThreads), 
+                          (total + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO);
+    
+    // Restaura a supressão de mensagens da thread mesmo se um solver lançar
+    struct SupressaoSaida {
+        const bool anterior = saidaSuprimidaNaThread;
+        SupressaoSaida() { saidaSuprimidaNaThread = true; }
+        ~SupressaoSaida() { saidaSuprimidaNaThread = anterior; }
+    };
+    
+    // Entre as consultas do lote a tabela da DP fica com a thread, dentro do
+    // teto; no fim, a thread chamadora volta à retenção pedida
+    OpcoesDP opcoesLote = opcoesDP;
+    opcoesLote.retencaoTabelaBytes = std::numeric_limits<std::size_t>::max();
+    
+    // Uma consulta que lança (ex.: bad_alloc da DP) esvazia a fila para as
+    // outras threads; a exceção chega a quem chamou depois que todas param
+    executarEmParalelo(numThreads, [&](int) {
+        const SupressaoSaida supressao;
+        try {
+            prepararEspacoTrabalho(algoritmo == Algoritmo::ProgramacaoDinamica, opcoesLote);
+            
+            while (true) {
+                const int inicio = proximo.fetch_add(TAMANHO_BLOCO, std::memory_order_relaxed);
+                if (inicio >= total) break;
+                
+                const int fim = std::min(total, inicio + TAMANHO_BLOCO);
+                for (int i = inicio; i < fim; ++i) {
+                    resultados[i] = resolver(algoritmo, consultas[i], opcoesLote);
+                }
+            }
+        } catch (...) {
+            proximo.store(total, std::memory_order_relaxed);
+            EspacoTrabalho::daThread().limitarTabelas(opcoesDP.limiteRetencao());
+            throw;
+        }
+        EspacoTrabalho::daThread().limitarTabelas(opcoesDP.limiteRetencao());
+    });
+    
+    return resultados;
+}
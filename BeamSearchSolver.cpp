@@ -0,0 +1,256 @@
+#include "Solver.h"
+#include "RelogioViagem.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+// BUSCA EM FEIXE - DP COM TETO DE MEMÓRIA
+//
+// Mesmas camadas de popcount da DP esparsa, mas cada camada guarda no máximo
+// larguraFeixe estados: os de maior pontuação e, no empate, menor custo (mais
+// orçamento sobrando). Enquanto nenhuma camada é truncada, a busca é a DP
+// esparsa e o resultado é ótimo; depois disso vira heurística.
+
+namespace {
+    constexpr double INFINITO = std::numeric_limits<double>::max() / 2;
+    constexpr double EPSILON = 1e-9;
+    constexpr uint32_t SEM_PAI = 0xFFFFFFFF;
+
+    struct EstadoFeixe {
+        uint64_t mascara;
+        double custo;        // Km acumulados, ou horário de saída no modo horário
+        uint32_t pai;        // Índice do predecessor na camada anterior
+        int32_t pontuacao;
+        uint8_t ultimo;
+    };
+
+    // Ordem de consolidação: (mascara, ultimo) e, para o mesmo estado,
+    // menor custo e depois menor predecessor
+    bool precede(const EstadoFeixe& a, const EstadoFeixe& b) {
+        if (a.mascara != b.mascara) return a.mascara < b.mascara;
+        if (a.ultimo != b.ultimo) return a.ultimo < b.ultimo;
+        if (a.custo != b.custo) return a.custo < b.custo;
+        return a.pai < b.pai;
+    }
+
+    // Ordem do feixe: maior pontuação, depois menor custo; (mascara, ultimo)
+    // desempata e torna a seleção determinística
+    bool melhorNoFeixe(const EstadoFeixe& a, const EstadoFeixe& b) {
+        if (a.pontuacao != b.pontuacao) return a.pontuacao > b.pontuacao;
+        if (a.custo != b.custo) return a.custo < b.custo;
+        if (a.mascara != b.mascara) return a.mascara < b.mascara;
+        return a.ultimo < b.ultimo;
+    }
+
+    // Mantém o estado mais barato de cada (mascara, ultimo) e, se ainda
+    // passar da largura, os melhores do feixe. Retorna true se truncou.
+    bool consolidarCamada(std::vector<EstadoFeixe>& camada, std::size_t larguraFeixe) {
+        std::sort(camada.begin(), camada.end(), precede);
+        auto fim = std::unique(camada.begin(), camada.end(),
+            [](const EstadoFeixe& a, const EstadoFeixe& b) {
+                return a.mascara == b.mascara && a.ultimo == b.ultimo;
+            });
+        camada.erase(fim, camada.end());
+
+        const bool truncou = camada.size() > larguraFeixe;
+        if (truncou) {
+            std::nth_element(camada.begin(), camada.begin() + larguraFeixe, camada.end(), melhorNoFeixe);
+            camada.resize(larguraFeixe);
+        }
+        camada.shrink_to_fit();
+        return truncou;
+    }
+}
+
+ResultadoSolucao OrienteeringProblemSolver::resolverBuscaFeixe(const ParametrosViagem& params,
+                                                               std::size_t memoriaMaximaBytes) {
+    auto inicioTempo = std::chrono::high_resolution_clock::now();
+    CronometroFases cronometro;
+
+    ResultadoSolucao resultado;
+
+    const int n = static_cast<int>(locais.size());
+    const double orcamentoKm = params.orcamentoKm();
+
+    if (n > MAX_LOCAIS_DP_ESPARSA) {
+        erros() << "Busca em feixe suporta ate " << MAX_LOCAIS_DP_ESPARSA
+                << " locais (" << n << " carregados). Use resolverGRASP.\n";
+        return resultado;
+    }
+
+    // Todas as camadas ficam guardadas para a reconstrução (até n · largura
+    // estados) e a camada em expansão tem no máximo n filhos por estado
+    const std::size_t larguraFeixe = std::max<std::size_t>(
+        1, memoriaMaximaBytes / (2 * static_cast<std::size_t>(std::max(n, 1)) * sizeof(EstadoFeixe)));
+
+    saida() << "Busca em feixe: ate " << larguraFeixe << " estados por camada ("
+            << memoriaMaximaBytes / (1024 * 1024) << " MB).\n";
+
+    const auto ponteiroDistOrigem = obterDistanciasOrigem(params);
+    const std::vector<double>& distOrigem = *ponteiroDistOrigem;
+
+    // Custos como na DP densa: km, ou horários no modo horário
+    const bool dependenteDoTempo = modoHorario();
+    const RelogioViagem relogio(perfilVelocidade, locais, zonaLocal, params, distOrigem);
+    const double orcamento = dependenteDoTempo ? relogio.limite() : orcamentoKm;
+
+    auto avancar = [&](double custo, double distanciaKm, int u) {
+        if (!dependenteDoTempo) return custo + distanciaKm;
+        return relogio.viajar(custo, distanciaKm, u);
+    };
+    auto visitar = [&](int v, double custo) {
+        if (!dependenteDoTempo) return custo;
+        return relogio.visitar(v, custo);
+    };
+    auto cabeComVolta = [&](double custo, int ultimo) {
+        return avancar(custo, distOrigem[ultimo], ultimo) <= orcamento + EPSILON;
+    };
+
+    // CASO BASE: Origem S -> primeiro local
+
+    const double custoInicial = dependenteDoTempo ? relogio.partida() : 0.0;
+    bool truncado = false;
+
+    std::vector<std::vector<EstadoFeixe>> camadas(1);
+    for (int i = 0; i < n; ++i) {
+        const double custo = visitar(i, avancar(custoInicial, distOrigem[i], -1));
+        if (custo <= orcamento + EPSILON && cabeComVolta(custo, i)) {
+            camadas[0].push_back({uint64_t(1) << i, custo, SEM_PAI, locais[i].pontuacao,
+                                  static_cast<uint8_t>(i)});
+        }
+    }
+
+    if (camadas[0].empty()) {
+        saida() << "Orcamento insuficiente para visitar qualquer local (ida + volta).\n";
+        auto fimTempo = std::chrono::high_resolution_clock::now();
+        resultado.tempoExecucaoMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            fimTempo - inicioTempo).count();
+        return resultado;
+    }
+
+    truncado |= consolidarCamada(camadas[0], larguraFeixe);
+
+    // Matriz de distâncias linearizada (no máximo 64 x 64) para o laço interno
+    std::vector<double> distancias(static_cast<std::size_t>(n) * n);
+    for (int u = 0; u < n; ++u) {
+        for (int v = 0; v < n; ++v) {
+            distancias[static_cast<std::size_t>(u) * n + v] = grafo.distancia(u, v);
+        }
+    }
+
+    resultado.metricas.preparacaoNs = cronometro.marcar();
+
+    // TRANSIÇÕES: expande o feixe camada a camada (popcount crescente)
+
+    Contador expandidos;
+    Contador podados;
+    while (!camadas.back().empty()) {
+        if (interrompida(params.interrupcao)) {
+            resultado.interrompida = true;
+            camadas.emplace_back();  // Removida logo abaixo, como a última camada vazia
+            break;
+        }
+
+        const std::vector<EstadoFeixe>& atual = camadas.back();
+        std::vector<EstadoFeixe> proxima;
+        proxima.reserve(atual.size() * static_cast<std::size_t>(n - static_cast<int>(camadas.size())));
+
+        for (std::size_t indice = 0; indice < atual.size(); ++indice) {
+            const EstadoFeixe& estado = atual[indice];
+            const double* distU = distancias.data() + static_cast<std::size_t>(estado.ultimo) * n;
+
+            for (int v = 0; v < n; ++v) {
+                const uint64_t bitV = uint64_t(1) << v;
+                if (estado.mascara & bitV) continue;
+
+                const double novoCusto = visitar(v, avancar(estado.custo, distU[v], estado.ultimo));
+                if (novoCusto > orcamento + EPSILON || !cabeComVolta(novoCusto, v)) {
+                    podados.somar();
+                    continue;
+                }
+
+                expandidos.somar();
+                proxima.push_back({estado.mascara | bitV, novoCusto, static_cast<uint32_t>(indice),
+                                   estado.pontuacao + locais[v].pontuacao, static_cast<uint8_t>(v)});
+            }
+        }
+
+        truncado |= consolidarCamada(proxima, larguraFeixe);
+        camadas.push_back(std::move(proxima));
+    }
+    camadas.pop_back();  // Última camada vazia
+    resultado.metricas.transicoesNs = cronometro.marcar();
+    resultado.metricas.estadosExpandidos = expandidos.total();
+    resultado.metricas.transicoesPodadas = podados.total();
+
+    // RECUPERAÇÃO DA MELHOR SOLUÇÃO (incluindo volta para S)
+
+    int melhorPontuacao = 0;
+    double melhorCustoTotal = INFINITO;
+    const EstadoFeixe* melhorEstado = nullptr;
+    std::size_t melhorCamada = 0;
+
+    for (std::size_t k = 0; k < camadas.size(); ++k) {
+        for (const auto& estado : camadas[k]) {
+            const double custoTotal = avancar(estado.custo, distOrigem[estado.ultimo], estado.ultimo);
+
+            bool melhor = estado.pontuacao > melhorPontuacao ||
+                          (estado.pontuacao == melhorPontuacao && custoTotal < melhorCustoTotal);
+            if (!melhor && melhorEstado && estado.pontuacao == melhorPontuacao && custoTotal == melhorCustoTotal) {
+                melhor = estado.mascara < melhorEstado->mascara ||
+                         (estado.mascara == melhorEstado->mascara && estado.ultimo < melhorEstado->ultimo);
+            }
+
+            if (melhor) {
+                melhorPontuacao = estado.pontuacao;
+                melhorCustoTotal = custoTotal;
+                melhorEstado = &estado;
+                melhorCamada = k;
+            }
+        }
+    }
+
+    resultado.metricas.recuperacaoNs = cronometro.marcar();
+
+    // RECONSTRUÇÃO DA ROTA
+
+    if (melhorEstado) {
+        std::vector<int> rota;
+        for (std::size_t k = melhorCamada + 1; k-- > 0; ) {
+            rota.push_back(melhorEstado->ultimo);
+            if (melhorEstado->pai == SEM_PAI) break;
+            melhorEstado = &camadas[k - 1][melhorEstado->pai];
+        }
+        std::reverse(rota.begin(), rota.end());
+
+        double custoKm = distOrigem[rota.front()];
+        for (std::size_t i = 1; i < rota.size(); ++i) {
+            custoKm += distancias[static_cast<std::size_t>(rota[i - 1]) * n + rota[i]];
+        }
+        custoKm += distOrigem[rota.back()];
+
+        resultado.rota = rota;
+        resultado.pontuacaoTotal = melhorPontuacao;
+        resultado.custoKm = custoKm;
+        resultado.tempoHoras = dependenteDoTempo ? melhorCustoTotal - relogio.partida()
+                                                 : custoKm / params.velocidadeKmh;
+        resultado.solucaoValida = true;
+    } else {
+        saida() << "Nenhuma rota valida encontrada dentro do orçamento de "
+                << params.orcamentoHoras << " horas (" << orcamentoKm << " km).\n";
+    }
+    resultado.metricas.reconstrucaoNs = cronometro.marcar();
+
+    resultado.otimoComprovado = resultado.solucaoValida && !truncado && !resultado.interrompida;
+    saida() << (truncado ? "Feixe truncado: solucao sem garantia de otimalidade.\n"
+                         : "Feixe nunca truncado: solucao otima.\n");
+
+    // Tempo de execução
+    auto fimTempo = std::chrono::high_resolution_clock::now();
+    resultado.tempoExecucaoMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        fimTempo - inicioTempo).count();
+
+    return resultado;
+}
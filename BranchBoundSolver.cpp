@@ -0,0 +1,446 @@
+#include "Solver.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+
+// BRANCH-AND-BOUND EXATO
+
+namespace {
+    constexpr double INFINITO = std::numeric_limits<double>::max() / 2;
+    constexpr double EPSILON = 1e-9;
+
+    // Tabela de dominância: até 128 candidatos cabem na chave e a tabela
+    // deixa de crescer depois deste número de estados
+    constexpr int MAX_CANDIDATOS_DOMINANCIA = 128;
+    constexpr std::size_t MAX_ESTADOS_DOMINANCIA = std::size_t(1) << 22;
+
+    // Nós explorados entre consultas à Interrupcao
+    constexpr long NOS_POR_VERIFICACAO = 1 << 12;
+
+    struct ChaveEstado {
+        uint64_t visitados[2];
+        int ultimo;
+
+        bool operator==(const ChaveEstado& outra) const {
+            return visitados[0] == outra.visitados[0] &&
+                   visitados[1] == outra.visitados[1] &&
+                   ultimo == outra.ultimo;
+        }
+    };
+
+    struct HashChaveEstado {
+        std::size_t operator()(const ChaveEstado& chave) const {
+            uint64_t h = chave.visitados[0] * 0x9E3779B97F4A7C15ULL;
+            h ^= chave.visitados[1] + 0x7F4A7C159E3779B9ULL + (h << 6) + (h >> 2);
+            h ^= static_cast<uint64_t>(chave.ultimo) * 0xC2B2AE3D27D4EB4FULL;
+            return static_cast<std::size_t>(h ^ (h >> 29));
+        }
+    };
+
+    // Busca em profundidade sobre os candidatos alcançáveis (ida + volta).
+    //
+    // Limitante superior: pontuação atual + mochila fracionária sobre os
+    // candidatos ainda alcançáveis, com capacidade igual ao orçamento restante
+    // e peso w[i] = metade da soma das duas menores arestas incidentes em i.
+    // Todo local intermediário do caminho restante tem duas arestas nele, e
+    // cada aresta é contada no máximo duas vezes, logo o caminho custa pelo
+    // menos a soma dos pesos dos locais visitados.
+    //
+    // Limitante inferior de custo: para superar a incumbente (ou empatá-la
+    // mais barato) uma extensão precisa juntar uma meta de pontos, e todo
+    // restante cuja falta já impede a meta é obrigatório. O caminho
+    // u -> ... -> S passa pelos obrigatórios e, encurtado pela desigualdade
+    // triangular, é uma árvore geradora de {u, S, obrigatórios}: custa pelo
+    // menos a árvore mínima. Quando todos os restantes cabem (orçamento
+    // folgado) a mochila não poda nada e é esse limitante que fecha os ramos.
+    //
+    // Caminho rápido: se a mochila diz que todos os restantes cabem, uma
+    // rota vizinho-mais-próximo por todos eles é tentada na hora; cabendo,
+    // vira incumbente com a pontuação máxima do ramo.
+    //
+    // Se a Interrupcao disparar, a busca desempilha sem explorar mais nós e
+    // fica com a melhor rota fechada encontrada até ali.
+    class BuscaBranchAndBound {
+    public:
+        BuscaBranchAndBound(const std::vector<double>& distancias,
+                            const std::vector<double>& distOrigem,
+                            const std::vector<int>& pontuacoes,
+                            double orcamentoKm,
+                            const Interrupcao* interrupcaoBusca)
+            : m(static_cast<int>(pontuacoes.size())),
+              dist(distancias), distS(distOrigem), pontos(pontuacoes),
+              orcamento(orcamentoKm), interrupcao(interrupcaoBusca), visitado(m, 0)
+        {
+            calcularPesos();
+            rotaAtual.reserve(m);
+        }
+
+        void executar() {
+            for (int i : ordemPorRazao(-1, 0.0)) {
+                if (parada) break;
+                visitar(i, distS[i], pontos[i]);
+            }
+        }
+
+        int melhorPontuacao = 0;
+        double melhorCusto = INFINITO;
+        std::vector<int> melhorRota;
+        long nosExplorados = 0;
+        Contador filhosPodados;  // Filhos que não voltariam a S no orçamento
+        bool parada = false;  // Interrompida antes de esgotar a árvore
+
+    private:
+        const int m;
+        const std::vector<double>& dist;
+        const std::vector<double>& distS;
+        const std::vector<int>& pontos;
+        const double orcamento;
+        const Interrupcao* const interrupcao;
+
+        std::vector<double> pesos;
+        std::vector<int> ordemFracionaria;  // Candidatos por pontos/peso decrescente
+        std::vector<char> visitado;
+        std::vector<int> rotaAtual;
+        std::vector<int> restantes;     // Alcançáveis com pontos, em ordemFracionaria
+        std::vector<int> obrigatorios;  // Vértices da árvore mínima além de u e S
+        std::vector<double> chave;      // Prim: menor aresta até a árvore
+        std::vector<char> naArvore;
+        std::unordered_map<ChaveEstado, double, HashChaveEstado> dominancia;
+        ChaveEstado chaveAtual{{0, 0}, -1};
+
+        double d(int i, int j) const { return dist[static_cast<std::size_t>(i) * m + j]; }
+
+        void calcularPesos() {
+            pesos.assign(m, 0.0);
+            for (int i = 0; i < m; ++i) {
+                double menor1 = distS[i];
+                double menor2 = INFINITO;
+                for (int j = 0; j < m; ++j) {
+                    if (j == i) continue;
+                    const double aresta = d(i, j);
+                    if (aresta < menor1) {
+                        menor2 = menor1;
+                        menor1 = aresta;
+                    } else if (aresta < menor2) {
+                        menor2 = aresta;
+                    }
+                }
+                // Sem segundo vizinho a rota só pode ser S -> i -> S
+                if (menor2 >= INFINITO) menor2 = distS[i];
+                pesos[i] = 0.5 * (menor1 + menor2);
+            }
+
+            // Locais sem pontuação não alteram o limitante
+            for (int i = 0; i < m; ++i) {
+                if (pontos[i] > 0) ordemFracionaria.push_back(i);
+            }
+            std::sort(ordemFracionaria.begin(), ordemFracionaria.end(), [&](int a, int b) {
+                // pontos[a]/pesos[a] > pontos[b]/pesos[b] sem dividir por zero
+                return pontos[a] * pesos[b] > pontos[b] * pesos[a];
+            });
+        }
+
+        bool alcancavel(int u, int i, double custo) const {
+            return custo + d(u, i) + distS[i] <= orcamento + EPSILON;
+        }
+
+        // Preenche 'restantes' e devolve a soma dos pontos deles
+        int coletarRestantes(int u, double custo) {
+            restantes.clear();
+            int soma = 0;
+            for (int i : ordemFracionaria) {
+                if (visitado[i] || !alcancavel(u, i, custo)) continue;
+                restantes.push_back(i);
+                soma += pontos[i];
+            }
+            return soma;
+        }
+
+        double limiteSuperior(int u, double custo, int pontuacao, bool& todosCabem) const {
+            // As pontas do caminho restante (a aresta que sai de u e a que
+            // chega em S) ficam fora dos pesos: metade de cada uma sobra
+            double saidaU = INFINITO, chegadaS = INFINITO;
+            for (int i : restantes) {
+                saidaU = std::min(saidaU, d(u, i));
+                chegadaS = std::min(chegadaS, distS[i]);
+            }
+            double capacidade = std::max(0.0, orcamento - custo - 0.5 * (saidaU + chegadaS));
+            double limite = pontuacao;
+
+            todosCabem = false;
+            for (int i : restantes) {
+                if (pesos[i] <= capacidade) {
+                    capacidade -= pesos[i];
+                    limite += pontos[i];
+                } else {
+                    limite += pontos[i] * (capacidade / pesos[i]);
+                    return limite;
+                }
+            }
+
+            todosCabem = true;
+            return limite;
+        }
+
+        // Menor custo de u até S juntando pelo menos 'meta' pontos entre os
+        // restantes (INFINITO se nem todos juntos bastam)
+        double custoMinimoAteMeta(int u, int meta, int somaRestantes) {
+            if (meta > somaRestantes) return INFINITO;
+
+            const int folga = somaRestantes - meta;
+            obrigatorios.clear();
+            for (int i : restantes) {
+                if (pontos[i] > folga) obrigatorios.push_back(i);
+            }
+            return arvoreMinima(u);
+        }
+
+        // Prim sobre {u, obrigatorios, S} a partir de u; S fica no índice k
+        double arvoreMinima(int u) {
+            const int k = static_cast<int>(obrigatorios.size());
+            chave.resize(k + 1);
+            naArvore.assign(k + 1, 0);
+            for (int j = 0; j < k; ++j) chave[j] = d(u, obrigatorios[j]);
+            chave[k] = distS[u];
+
+            double total = 0.0;
+            for (int passo = 0; passo <= k; ++passo) {
+                int proximo = -1;
+                for (int j = 0; j <= k; ++j) {
+                    if (!naArvore[j] && (proximo == -1 || chave[j] < chave[proximo])) proximo = j;
+                }
+                naArvore[proximo] = 1;
+                total += chave[proximo];
+
+                for (int j = 0; j <= k; ++j) {
+                    if (naArvore[j]) continue;
+                    const double aresta = (proximo == k) ? distS[obrigatorios[j]]
+                                        : (j == k)       ? distS[obrigatorios[proximo]]
+                                                         : d(obrigatorios[proximo], obrigatorios[j]);
+                    chave[j] = std::min(chave[j], aresta);
+                }
+            }
+            return total;
+        }
+
+        // Caminho rápido: u -> vizinho mais próximo entre os restantes -> ... -> S
+        void completarComTodos(double custo, int pontuacao, int somaRestantes) {
+            const std::size_t tamanhoRota = rotaAtual.size();
+            obrigatorios = restantes;  // Ainda não visitados pela completação
+            int atual = rotaAtual.back();
+
+            while (!obrigatorios.empty()) {
+                auto proximo = std::min_element(obrigatorios.begin(), obrigatorios.end(), [&](int a, int b) {
+                    return d(atual, a) < d(atual, b);
+                });
+                custo += d(atual, *proximo);
+                atual = *proximo;
+                rotaAtual.push_back(atual);
+                *proximo = obrigatorios.back();
+                obrigatorios.pop_back();
+            }
+            custo += distS[atual];
+
+            if (custo <= orcamento + EPSILON) {
+                melhorPontuacao = pontuacao + somaRestantes;
+                melhorCusto = custo;
+                melhorRota = rotaAtual;
+            }
+            rotaAtual.resize(tamanhoRota);
+        }
+
+        // Filhos ordenados pela razão do guloso (pontuação / distância), para
+        // encontrar boas soluções incumbentes cedo
+        std::vector<int> ordemPorRazao(int u, double custo) {
+            std::vector<int> filhos;
+            for (int i = 0; i < m; ++i) {
+                if (visitado[i]) continue;
+                if (u == -1 ? 2.0 * distS[i] > orcamento + EPSILON : !alcancavel(u, i, custo)) {
+                    filhosPodados.somar();
+                    continue;
+                }
+                filhos.push_back(i);
+            }
+
+            auto razao = [&](int i) {
+                const double distancia = (u == -1) ? distS[i] : d(u, i);
+                return pontos[i] / (distancia + EPSILON);
+            };
+            std::stable_sort(filhos.begin(), filhos.end(), [&](int a, int b) {
+                return razao(a) > razao(b);
+            });
+            return filhos;
+        }
+
+        // Retorna true se o estado (visitados, u) já foi alcançado com custo menor ou igual
+        bool dominado(int u, double custo) {
+            if (m > MAX_CANDIDATOS_DOMINANCIA) return false;
+
+            chaveAtual.ultimo = u;
+            auto it = dominancia.find(chaveAtual);
+            if (it != dominancia.end()) {
+                if (it->second <= custo) return true;
+                it->second = custo;
+            } else if (dominancia.size() < MAX_ESTADOS_DOMINANCIA) {
+                dominancia.emplace(chaveAtual, custo);
+            }
+            return false;
+        }
+
+        void alternarBit(int i) {
+            if (m <= MAX_CANDIDATOS_DOMINANCIA) {
+                chaveAtual.visitados[i >> 6] ^= uint64_t(1) << (i & 63);
+            }
+        }
+
+        void visitar(int u, double custo, int pontuacao) {
+            visitado[u] = 1;
+            alternarBit(u);
+            rotaAtual.push_back(u);
+
+            explorar(u, custo, pontuacao);
+
+            rotaAtual.pop_back();
+            alternarBit(u);
+            visitado[u] = 0;
+        }
+
+        void explorar(int u, double custo, int pontuacao) {
+            ++nosExplorados;
+
+            if (nosExplorados % NOS_POR_VERIFICACAO == 0 && interrompida(interrupcao)) parada = true;
+            if (parada || dominado(u, custo)) return;
+
+            // Fechar a rota aqui já é uma solução viável
+            const double custoFechado = custo + distS[u];
+            if (pontuacao > melhorPontuacao ||
+                (pontuacao == melhorPontuacao && custoFechado < melhorCusto))
+            {
+                melhorPontuacao = pontuacao;
+                melhorCusto = custoFechado;
+                melhorRota = rotaAtual;
+            }
+
+            // Poda: nenhuma extensão supera a pontuação incumbente, nem a
+            // empata com custo menor
+            const int somaRestantes = coletarRestantes(u, custo);
+            bool todosCabem;
+            const int limite = static_cast<int>(std::floor(limiteSuperior(u, custo, pontuacao, todosCabem) + EPSILON));
+            if (limite < melhorPontuacao) return;
+
+            if (todosCabem && pontuacao + somaRestantes > melhorPontuacao) {
+                completarComTodos(custo, pontuacao, somaRestantes);
+            }
+
+            const int metaSuperar = melhorPontuacao + 1 - pontuacao;
+            const int metaEmpatar = melhorPontuacao - pontuacao;
+            const bool podeSuperar = limite > melhorPontuacao &&
+                custo + custoMinimoAteMeta(u, metaSuperar, somaRestantes) <= orcamento + EPSILON;
+            const bool podeEmpatar = !podeSuperar && metaEmpatar > 0 &&
+                custo + custoMinimoAteMeta(u, metaEmpatar, somaRestantes) < melhorCusto + EPSILON;
+            if (!podeSuperar && !podeEmpatar) return;
+
+            for (int v : ordemPorRazao(u, custo)) {
+                if (parada) return;
+                visitar(v, custo + d(u, v), pontuacao + pontos[v]);
+            }
+        }
+    };
+}
+
+ResultadoSolucao OrienteeringProblemSolver::resolverBranchAndBound(const ParametrosViagem& params) {
+    auto inicioTempo = std::chrono::high_resolution_clock::now();
+    CronometroFases cronometro;
+
+    saida() << "\nIniciando Branch-and-Bound (Solucao otima)...\n";
+
+    ResultadoSolucao resultado;
+
+    // Validações
+    if (!params.validar()) {
+        erros() << "Parametros de viagem invalidos.\n";
+        return resultado;
+    }
+    
+    if (recusaModoHorario("Branch-and-Bound")) {
+        return resultado;
+    }
+
+    validarDados();
+
+    const int n = static_cast<int>(locais.size());
+    const double orcamentoKm = params.orcamentoKm();
+
+    const auto distanciasOrigem = obterDistanciasOrigem(params);
+    
+    // Apenas locais com ida + volta dentro do orçamento podem ser visitados
+    std::vector<int> candidatos;
+    std::vector<double> distOrigem;
+    std::vector<int> pontuacoes;
+    for (int i = 0; i < n; ++i) {
+        const double distancia = (*distanciasOrigem)[i];
+        if (2.0 * distancia <= orcamentoKm + EPSILON) {
+            candidatos.push_back(i);
+            distOrigem.push_back(distancia);
+            pontuacoes.push_back(locais[i].pontuacao);
+        }
+    }
+
+    if (candidatos.empty()) {
+        saida() << "Orcamento insuficiente para visitar qualquer local (ida + volta).\n";
+        auto fimTempo = std::chrono::high_resolution_clock::now();
+        resultado.tempoExecucaoMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            fimTempo - inicioTempo).count();
+        return resultado;
+    }
+
+    // Submatriz de distâncias dos candidatos, linearizada
+    const int m = static_cast<int>(candidatos.size());
+    std::vector<double> distancias(static_cast<std::size_t>(m) * m);
+    for (int a = 0; a < m; ++a) {
+        for (int b = 0; b < m; ++b) {
+            distancias[static_cast<std::size_t>(a) * m + b] = grafo.distancia(candidatos[a], candidatos[b]);
+        }
+    }
+
+    BuscaBranchAndBound busca(distancias, distOrigem, pontuacoes, orcamentoKm, params.interrupcao);
+    resultado.metricas.preparacaoNs = cronometro.marcar();
+
+    // A incumbente é mantida durante a busca: não há fase de recuperação
+    busca.executar();
+    resultado.interrompida = busca.parada;
+    resultado.metricas.transicoesNs = cronometro.marcar();
+    resultado.metricas.estadosExpandidos = static_cast<uint64_t>(busca.nosExplorados);
+    resultado.metricas.transicoesPodadas = busca.filhosPodados.total();
+
+    if (!busca.melhorRota.empty() && busca.melhorCusto <= orcamentoKm + EPSILON) {
+        for (int indice : busca.melhorRota) {
+            resultado.rota.push_back(candidatos[indice]);
+        }
+        resultado.pontuacaoTotal = busca.melhorPontuacao;
+        resultado.custoKm = busca.melhorCusto;
+        resultado.tempoHoras = busca.melhorCusto / params.velocidadeKmh;
+        resultado.solucaoValida = true;
+        resultado.otimoComprovado = !busca.parada;
+    } else {
+        saida() << "Nenhuma rota valida encontrada dentro do orçamento de "
+                << params.orcamentoHoras << " horas (" << orcamentoKm << " km).\n";
+    }
+    resultado.metricas.reconstrucaoNs = cronometro.marcar();
+
+    saida() << "Nos explorados: " << busca.nosExplorados << "\n";
+    if (busca.parada) {
+        saida() << "Prazo esgotado: retornando a melhor rota encontrada ate aqui.\n";
+    }
+
+    // Tempo de execução
+    auto fimTempo = std::chrono::high_resolution_clock::now();
+    resultado.tempoExecucaoMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        fimTempo - inicioTempo).count();
+
+    return resultado;
+}
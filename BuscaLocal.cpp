@@ -0,0 +1,223 @@
+#include "BuscaLocal.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+    constexpr double INFINITO = std::numeric_limits<double>::max() / 2;
+    constexpr double EPSILON = 1e-9;
+    constexpr int ORIGEM = -1;
+}
+
+BuscaLocal::BuscaLocal(const GrafoDistancias& distancias,
+                       const std::vector<double>& distOrigem,
+                       const std::vector<int>& pontuacoes,
+                       double orcamentoKm)
+    : dist(distancias), distS(distOrigem), pontos(pontuacoes), orcamento(orcamentoKm),
+      visitado(pontuacoes.size(), 0)
+{
+    for (int i = 0; i < static_cast<int>(pontuacoes.size()); ++i) {
+        if (2.0 * distS[i] <= orcamento + EPSILON) {
+            candidatos.push_back(i);
+        }
+    }
+}
+
+int BuscaLocal::localNaPosicao(int posicao) const {
+    if (posicao < 0 || posicao >= static_cast<int>(rota->size())) return ORIGEM;
+    return (*rota)[posicao];
+}
+
+double BuscaLocal::d(int a, int b) const {
+    if (a == ORIGEM && b == ORIGEM) return 0.0;
+    if (a == ORIGEM) return distS[b];
+    if (b == ORIGEM) return distS[a];
+    return dist.distancia(a, b);
+}
+
+void BuscaLocal::melhorar(std::vector<int>& rotaInicial) {
+    rota = &rotaInicial;
+    
+    std::fill(visitado.begin(), visitado.end(), 0);
+    pontuacaoAtual = 0;
+    custoAtual = 0.0;
+    
+    int anterior = ORIGEM;
+    for (int local : rotaInicial) {
+        visitado[local] = 1;
+        pontuacaoAtual += pontos[local];
+        custoAtual += d(anterior, local);
+        anterior = local;
+    }
+    custoAtual += d(anterior, ORIGEM);
+    
+    bool melhorou = true;
+    while (melhorou) {
+        while (aplicar2Opt() || aplicarRealocacao()) {}
+        
+        melhorou = false;
+        while (aplicarInsercao()) melhorou = true;
+        if (aplicarTroca()) melhorou = true;
+    }
+    
+    rota = nullptr;
+}
+
+// 2-OPT: inverter r[i..j] troca as arestas (a, r[i]) e (r[j], b) por
+// (a, r[j]) e (r[i], b); o interior do trecho não muda de custo
+bool BuscaLocal::aplicar2Opt() {
+    const int k = static_cast<int>(rota->size());
+    
+    double melhorDelta = -EPSILON;
+    int melhorI = -1;
+    int melhorJ = -1;
+    
+    for (int i = 0; i < k; ++i) {
+        const int a = localNaPosicao(i - 1);
+        const int ri = (*rota)[i];
+        const double arestaA = d(a, ri);
+        
+        for (int j = i + 1; j < k; ++j) {
+            const int rj = (*rota)[j];
+            const int b = localNaPosicao(j + 1);
+            
+            const double delta = d(a, rj) + d(ri, b) - arestaA - d(rj, b);
+            if (delta < melhorDelta) {
+                melhorDelta = delta;
+                melhorI = i;
+                melhorJ = j;
+            }
+        }
+    }
+    
+    if (melhorI == -1) return false;
+    
+    std::reverse(rota->begin() + melhorI, rota->begin() + melhorJ + 1);
+    custoAtual += melhorDelta;
+    ++movimentos2Opt;
+    return true;
+}
+
+// REALOCAÇÃO (or-opt de um local): tira r[i] de entre seus vizinhos e o
+// recoloca entre outros dois, se isso encurtar a rota
+bool BuscaLocal::aplicarRealocacao() {
+    const int k = static_cast<int>(rota->size());
+    
+    double melhorDelta = -EPSILON;
+    int melhorOrigem = -1;
+    int melhorDestino = -1;
+    
+    for (int i = 0; i < k; ++i) {
+        const int a = localNaPosicao(i - 1);
+        const int u = (*rota)[i];
+        const int b = localNaPosicao(i + 1);
+        const double ganhoRemocao = d(a, u) + d(u, b) - d(a, b);
+        
+        // Destino p: entre as posições p - 1 e p da rota sem u
+        for (int p = 0; p < k; ++p) {
+            if (p == i) continue;
+            const int x = localNaPosicao(p < i ? p - 1 : p);
+            const int y = localNaPosicao(p < i ? p : p + 1);
+            
+            const double delta = d(x, u) + d(u, y) - d(x, y) - ganhoRemocao;
+            if (delta < melhorDelta) {
+                melhorDelta = delta;
+                melhorOrigem = i;
+                melhorDestino = p;
+            }
+        }
+    }
+    
+    if (melhorOrigem == -1) return false;
+    
+    const int local = (*rota)[melhorOrigem];
+    rota->erase(rota->begin() + melhorOrigem);
+    rota->insert(rota->begin() + melhorDestino, local);
+    custoAtual += melhorDelta;
+    ++realocacoes;
+    return true;
+}
+
+// INSERÇÃO: maior pontuação primeiro; entre iguais, o menor acréscimo
+bool BuscaLocal::aplicarInsercao() {
+    const int k = static_cast<int>(rota->size());
+    const double folga = orcamento - custoAtual + EPSILON;
+    
+    int melhorLocal = -1;
+    int melhorPosicao = -1;
+    double melhorDelta = INFINITO;
+    
+    for (int v : candidatos) {
+        if (visitado[v] || pontos[v] <= 0) continue;
+        if (melhorLocal != -1 && pontos[v] < pontos[melhorLocal]) continue;
+        
+        for (int p = 0; p <= k; ++p) {
+            const int a = localNaPosicao(p - 1);
+            const int b = localNaPosicao(p);
+            
+            const double delta = d(a, v) + d(v, b) - d(a, b);
+            if (delta > folga) continue;
+            
+            if (melhorLocal == -1 || pontos[v] > pontos[melhorLocal] || delta < melhorDelta) {
+                melhorLocal = v;
+                melhorPosicao = p;
+                melhorDelta = delta;
+            }
+        }
+    }
+    
+    if (melhorLocal == -1) return false;
+    
+    rota->insert(rota->begin() + melhorPosicao, melhorLocal);
+    visitado[melhorLocal] = 1;
+    pontuacaoAtual += pontos[melhorLocal];
+    custoAtual += melhorDelta;
+    ++insercoes;
+    return true;
+}
+
+// TROCA: maior ganho de pontuação primeiro; entre iguais, o menor delta.
+// Trocas sem ganho só valem se encurtarem a rota.
+bool BuscaLocal::aplicarTroca() {
+    const int k = static_cast<int>(rota->size());
+    const double folga = orcamento - custoAtual + EPSILON;
+    
+    int melhorGanho = 0;
+    double melhorDelta = -EPSILON;
+    int melhorPosicao = -1;
+    int melhorLocal = -1;
+    
+    for (int p = 0; p < k; ++p) {
+        const int a = localNaPosicao(p - 1);
+        const int u = (*rota)[p];
+        const int b = localNaPosicao(p + 1);
+        const double custoU = d(a, u) + d(u, b);
+        
+        for (int v : candidatos) {
+            if (visitado[v]) continue;
+            
+            const int ganho = pontos[v] - pontos[u];
+            if (ganho < melhorGanho) continue;
+            
+            const double delta = d(a, v) + d(v, b) - custoU;
+            if (delta > folga) continue;
+            
+            if (ganho > melhorGanho || delta < melhorDelta) {
+                melhorGanho = ganho;
+                melhorDelta = delta;
+                melhorPosicao = p;
+                melhorLocal = v;
+            }
+        }
+    }
+    
+    if (melhorLocal == -1) return false;
+    
+    const int removido = (*rota)[melhorPosicao];
+    (*rota)[melhorPosicao] = melhorLocal;
+    visitado[removido] = 0;
+    visitado[melhorLocal] = 1;
+    pontuacaoAtual += melhorGanho;
+    custoAtual += melhorDelta;
+    ++trocas;
+    return true;
+}
@@ -0,0 +1,59 @@
+#ifndef BUSCA_LOCAL_H
+#define BUSCA_LOCAL_H
+
+#include "GrafoDistancias.h"
+#include <vector>
+
+// BUSCA LOCAL SOBRE UMA ROTA S -> r[0] -> ... -> r[k-1] -> S
+//
+// Vizinhanças avaliadas com deltas O(1) sobre as distâncias (simétricas):
+//   2-opt    inverte um trecho da rota; só é aplicado se reduzir o custo,
+//            liberando orçamento para as próximas inserções
+//   realocação move um local para outra posição, também só se reduzir o custo
+//   inserção coloca um local não visitado na posição mais barata, se couber
+//   troca    substitui um local visitado por um não visitado de pontuação
+//            maior (ou igual, desde que a rota fique mais curta)
+// A busca alterna as vizinhanças até nenhuma melhorar a rota. Cada movimento
+// aumenta a pontuação ou reduz o custo, então a busca sempre termina.
+
+class BuscaLocal {
+	public:
+	    BuscaLocal(const GrafoDistancias& distancias,
+	               const std::vector<double>& distOrigem,
+	               const std::vector<int>& pontuacoes,
+	               double orcamentoKm);
+	    
+	    // Melhora a rota no lugar; a rota inicial deve respeitar o orçamento
+	    void melhorar(std::vector<int>& rota);
+	    
+	    int pontuacao() const { return pontuacaoAtual; }
+	    double custo() const { return custoAtual; }
+	    
+	    long movimentos2Opt = 0;
+	    long realocacoes = 0;
+	    long insercoes = 0;
+	    long trocas = 0;
+
+	private:
+	    const GrafoDistancias& dist;
+	    const std::vector<double>& distS;
+	    const std::vector<int>& pontos;
+	    const double orcamento;
+	    
+	    std::vector<int> candidatos;  // Locais com ida + volta dentro do orçamento
+	    std::vector<char> visitado;
+	    std::vector<int>* rota = nullptr;
+	    int pontuacaoAtual = 0;
+	    double custoAtual = 0.0;
+	    
+	    // Distância entre posições vizinhas; -1 e rota.size() são a origem
+	    double d(int a, int b) const;
+	    int localNaPosicao(int posicao) const;
+	    
+	    bool aplicar2Opt();
+	    bool aplicarRealocacao();
+	    bool aplicarInsercao();
+	    bool aplicarTroca();
+};
+
+#endif // BUSCA_LOCAL_H
@@ -0,0 +1,69 @@
+#ifndef CACHE_ORIGEM_H
+#define CACHE_ORIGEM_H
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// CACHE LRU DE DISTÂNCIAS ORIGEM -> LOCAIS
+//
+// Consultas costumam partir de poucos pontos (hotéis, aeroporto), então o
+// vetor S -> i de cada origem recente é guardado e compartilhado entre as
+// consultas. A chave é a coordenada exata de partida. Os vetores são
+// imutáveis e entregues por shared_ptr, então continuam válidos para quem
+// os está usando mesmo após serem removidos do cache.
+
+class CacheDistanciasOrigem {
+	public:
+	    using Distancias = std::shared_ptr<const std::vector<double>>;
+
+	    explicit CacheDistanciasOrigem(std::size_t capacidadeMaxima = 32) : capacidade(capacidadeMaxima) {}
+
+	    // Retorna nullptr se a origem não estiver no cache
+	    Distancias buscar(double latitude, double longitude) {
+	        std::lock_guard<std::mutex> trava(mutex);
+
+	        for (auto it = entradas.begin(); it != entradas.end(); ++it) {
+	            if (it->latitude == latitude && it->longitude == longitude) {
+	                entradas.splice(entradas.begin(), entradas, it);  // Mais recente na frente
+	                return it->distancias;
+	            }
+	        }
+
+	        return nullptr;
+	    }
+
+	    void inserir(double latitude, double longitude, Distancias distancias) {
+	        std::lock_guard<std::mutex> trava(mutex);
+
+	        // Outra thread pode ter calculado a mesma origem em paralelo
+	        for (const auto& entrada : entradas) {
+	            if (entrada.latitude == latitude && entrada.longitude == longitude) return;
+	        }
+
+	        entradas.push_front({latitude, longitude, std::move(distancias)});
+	        if (entradas.size() > capacidade) {
+	            entradas.pop_back();
+	        }
+	    }
+
+	    void limpar() {
+	        std::lock_guard<std::mutex> trava(mutex);
+	        entradas.clear();
+	    }
+
+	private:
+	    struct Entrada {
+	        double latitude;
+	        double longitude;
+	        Distancias distancias;
+	    };
+
+	    std::mutex mutex;
+	    std::list<Entrada> entradas;
+	    std::size_t capacidade;
+};
+
+#endif // CACHE_ORIGEM_H
@@ -0,0 +1,175 @@
+#include "DPKernels.h"
+#include <limits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define OP_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+// KERNELS ESCALARES
+
+namespace {
+    template <typename Custo>
+    int minimoEscalar(const Custo* custos, const double* distancias, int n, double* minimo) {
+        double melhor = std::numeric_limits<double>::infinity();
+        int indice = -1;
+
+        for (int u = 0; u < n; ++u) {
+            const double soma = static_cast<double>(custos[u]) + distancias[u];
+            if (soma < melhor) {
+                melhor = soma;
+                indice = u;
+            }
+        }
+
+        *minimo = melhor;
+        return indice;
+    }
+
+    // Primeiro índice cuja soma é igual ao mínimo já reduzido
+    template <typename Custo>
+    int primeiroIndiceDoMinimo(const Custo* custos, const double* distancias, int n, double minimo) {
+        for (int u = 0; u < n; ++u) {
+            if (static_cast<double>(custos[u]) + distancias[u] == minimo) return u;
+        }
+        return -1;
+    }
+}
+
+#ifdef OP_KERNELS_X86
+
+// Falsos positivos do GCC dentro dos próprios headers de intrínsecos
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// KERNELS AVX2
+
+namespace {
+    __attribute__((target("avx2")))
+    double reduzirMinimo(__m256d valores) {
+        const __m128d metade = _mm_min_pd(_mm256_castpd256_pd128(valores),
+                                          _mm256_extractf128_pd(valores, 1));
+        return _mm_cvtsd_f64(_mm_min_sd(metade, _mm_unpackhi_pd(metade, metade)));
+    }
+
+    __attribute__((target("avx2")))
+    int minimoDoubleAvx2(const double* custos, const double* distancias, int n, double* minimo) {
+        __m256d melhor = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+        int u = 0;
+
+        for (; u + 4 <= n; u += 4) {
+            const __m256d soma = _mm256_add_pd(_mm256_loadu_pd(custos + u),
+                                               _mm256_loadu_pd(distancias + u));
+            melhor = _mm256_min_pd(melhor, soma);
+        }
+
+        double valor = reduzirMinimo(melhor);
+        for (; u < n; ++u) {
+            const double soma = custos[u] + distancias[u];
+            if (soma < valor) valor = soma;
+        }
+
+        *minimo = valor;
+        return primeiroIndiceDoMinimo(custos, distancias, n, valor);
+    }
+
+    __attribute__((target("avx2")))
+    int minimoFloatAvx2(const float* custos, const double* distancias, int n, double* minimo) {
+        __m256d melhor = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+        int u = 0;
+
+        for (; u + 4 <= n; u += 4) {
+            const __m256d soma = _mm256_add_pd(_mm256_cvtps_pd(_mm_loadu_ps(custos + u)),
+                                               _mm256_loadu_pd(distancias + u));
+            melhor = _mm256_min_pd(melhor, soma);
+        }
+
+        double valor = reduzirMinimo(melhor);
+        for (; u < n; ++u) {
+            const double soma = static_cast<double>(custos[u]) + distancias[u];
+            if (soma < valor) valor = soma;
+        }
+
+        *minimo = valor;
+        return primeiroIndiceDoMinimo(custos, distancias, n, valor);
+    }
+}
+
+// KERNELS AVX-512
+
+namespace {
+    __attribute__((target("avx512f")))
+    int minimoDoubleAvx512(const double* custos, const double* distancias, int n, double* minimo) {
+        __m512d melhor = _mm512_set1_pd(std::numeric_limits<double>::infinity());
+        int u = 0;
+
+        for (; u + 8 <= n; u += 8) {
+            const __m512d soma = _mm512_add_pd(_mm512_loadu_pd(custos + u),
+                                               _mm512_loadu_pd(distancias + u));
+            melhor = _mm512_min_pd(melhor, soma);
+        }
+
+        // Cauda mascarada: lanes fora de [u, n) permanecem em +infinito
+        if (u < n) {
+            const __mmask8 ativos = static_cast<__mmask8>((1u << (n - u)) - 1);
+            const __m512d soma = _mm512_add_pd(_mm512_maskz_loadu_pd(ativos, custos + u),
+                                               _mm512_maskz_loadu_pd(ativos, distancias + u));
+            melhor = _mm512_mask_min_pd(melhor, ativos, melhor, soma);
+        }
+
+        const double valor = _mm512_reduce_min_pd(melhor);
+        *minimo = valor;
+        return primeiroIndiceDoMinimo(custos, distancias, n, valor);
+    }
+
+    __attribute__((target("avx512f")))
+    int minimoFloatAvx512(const float* custos, const double* distancias, int n, double* minimo) {
+        __m512d melhor = _mm512_set1_pd(std::numeric_limits<double>::infinity());
+        int u = 0;
+
+        for (; u + 8 <= n; u += 8) {
+            const __m512d soma = _mm512_add_pd(_mm512_cvtps_pd(_mm256_loadu_ps(custos + u)),
+                                               _mm512_loadu_pd(distancias + u));
+            melhor = _mm512_min_pd(melhor, soma);
+        }
+
+        if (u < n) {
+            const __mmask8 ativos = static_cast<__mmask8>((1u << (n - u)) - 1);
+            const __m512d soma = _mm512_add_pd(_mm512_cvtps_pd(_mm512_castps512_ps256(
+                                                   _mm512_maskz_loadu_ps(ativos, custos + u))),
+                                               _mm512_maskz_loadu_pd(ativos, distancias + u));
+            melhor = _mm512_mask_min_pd(melhor, ativos, melhor, soma);
+        }
+
+        const double valor = _mm512_reduce_min_pd(melhor);
+        *minimo = valor;
+        return primeiroIndiceDoMinimo(custos, distancias, n, valor);
+    }
+}
+
+#endif // OP_KERNELS_X86
+
+// DESPACHO POR CPU
+
+const KernelsDP& kernelsDPEscalares() {
+    static const KernelsDP escalares{minimoEscalar<double>, minimoEscalar<float>, "escalar"};
+    return escalares;
+}
+
+const KernelsDP& kernelsDPDetectados() {
+    static const KernelsDP detectados = []() -> KernelsDP {
+#ifdef OP_KERNELS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return {minimoDoubleAvx512, minimoFloatAvx512, "avx512"};
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return {minimoDoubleAvx2, minimoFloatAvx2, "avx2"};
+        }
+#endif
+        return kernelsDPEscalares();
+    }();
+
+    return detectados;
+}
@@ -0,0 +1,27 @@
+#ifndef DP_KERNELS_H
+#define DP_KERNELS_H
+
+// KERNELS VETORIZADOS DA TRANSIÇÃO HELD-KARP
+//
+// Cada kernel calcula min(custos[u] + distancias[u]) para u em [0, n) e
+// devolve o primeiro índice que atinge o mínimo, escrevendo o valor em
+// *minimo. Estados ausentes da máscara valem INFINITO na tabela, então a
+// redução dispensa o teste de bits. Todas as variantes fazem as mesmas
+// somas em double e escolhem o mesmo índice, logo produzem rotas idênticas.
+
+using KernelMinimoDouble = int (*)(const double* custos, const double* distancias, int n, double* minimo);
+using KernelMinimoFloat = int (*)(const float* custos, const double* distancias, int n, double* minimo);
+
+struct KernelsDP {
+    KernelMinimoDouble minimoDouble;
+    KernelMinimoFloat minimoFloat;
+    const char* nome;
+};
+
+// Melhor variante para a CPU atual (AVX-512, AVX2 ou escalar), detectada uma vez
+const KernelsDP& kernelsDPDetectados();
+
+// Variante escalar, para comparação e para CPUs sem suporte vetorial
+const KernelsDP& kernelsDPEscalares();
+
+#endif // DP_KERNELS_H
@@ -1,165 +1,718 @@
 #include "Solver.h"
+#include "RelogioViagem.h"
+#include "TabelaDP.h"
+#include "DPKernels.h"
+#include "EspacoTrabalho.h"
+#include "Paralelismo.h"
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <iterator>
 #include <limits>
 #include <iostream>
+#include <type_traits>
 
 // PROGRAMAÇÃO DINÂMICA - HELD-KARP COM BITMASK
 
 namespace {
     constexpr double INFINITO = std::numeric_limits<double>::max() / 2;
     constexpr double EPSILON = 1e-9;
-}
-
-ResultadoSolucao OrienteeringProblemSolver::resolverProgramacaoDinamica(const ParametrosViagem& params) {
-    auto inicioTempo = std::chrono::high_resolution_clock::now();
     
-    std::cout << "\nIniciando Programacao Dinamica (Solucao otima)...\n";
+    // Máscaras entre consultas à Interrupcao na varredura sequencial
+    constexpr int MASCARAS_POR_VERIFICACAO = 1 << 12;
     
-    ResultadoSolucao resultado;
+    // Dados somente leitura compartilhados pelas threads da DP; os vetores
+    // vêm da arena da thread que chamou o solver
+    //
+    // No modo horário os custos da tabela são horários de saída do último
+    // local (o mais cedo domina, por FIFO) e o orçamento é o horário limite
+    // de volta; fora dele são quilômetros acumulados.
+    struct ContextoDP {
+        const double* distancias;            // Matriz n x n linearizada
+        const std::vector<double>* distOrigem;
+        const int* pontuacaoMascara;         // Pontuação total de cada máscara
+        double orcamento;                    // Km, ou horário limite no modo horário
+        
+        const RelogioViagem* relogio = nullptr;
+        double custoInicial = 0.0;           // Custo em S: 0 km, ou o horário de partida
+        const Interrupcao* interrupcao = nullptr;
+        
+        // Custo depois de percorrer distanciaKm saindo de u (-1 = origem S)
+        double avancar(double custo, double distanciaKm, int u) const {
+            if (!relogio) return custo + distanciaKm;
+            return relogio->viajar(custo, distanciaKm, u);
+        }
+        
+        // Custo ao deixar v chegando com 'custo' (espera e visita)
+        double visitar(int v, double custo) const {
+            if (!relogio) return custo;
+            return relogio->visitar(v, custo);
+        }
+    };
     
-    // Validações
-    if (!params.validar()) {
-        std::cerr << "Parametros de viagem invalidos.\n";
-        return resultado;
-    }
+    // Melhor estado fechado (com volta para S) encontrado na varredura
+    struct MelhorEstadoDP {
+        int pontuacao = 0;
+        double custoTotal = INFINITO;
+        int mascara = 0;
+        int ultimo = -1;
+        
+        // Maior pontuação, depois menor custo; o desempate final por
+        // (mascara, ultimo) crescentes reproduz a varredura sequencial
+        // original e torna a redução entre threads determinística
+        bool melhorQue(const MelhorEstadoDP& outro) const {
+            if (pontuacao != outro.pontuacao) return pontuacao > outro.pontuacao;
+            if (custoTotal != outro.custoTotal) return custoTotal < outro.custoTotal;
+            if (mascara != outro.mascara) return mascara < outro.mascara;
+            return ultimo < outro.ultimo;
+        }
+    };
     
-    validarDados();
+    // Contadores de uma thread da varredura, em linhas de cache separadas
+    struct alignas(64) ContadoresDP {
+        Contador expandidos;  // Estados (mascara, v) calculados
+        Contador podados;     // Desses, os que estouraram o orçamento
+        
+        void somar(const ContadoresDP& outros) {
+            expandidos.somar(outros.expandidos.total());
+            podados.somar(outros.podados.total());
+        }
+    };
     
-    const int n = static_cast<int>(locais.size());
-    const int numEstados = 1 << n;
-    const double orcamentoKm = params.orcamentoKm();
+    // score[m] = score[m sem o bit mais baixo] + pontuação desse bit
+    const int* construirPontuacaoMascaras(const std::vector<Local>& locais, ArenaTrabalho& arena) {
+        const int numEstados = 1 << static_cast<int>(locais.size());
+        int* pontuacao = arena.alocar<int>(numEstados);
+        pontuacao[0] = 0;
+        
+        for (int mascara = 1; mascara < numEstados; ++mascara) {
+            pontuacao[mascara] = pontuacao[mascara & (mascara - 1)] +
+                                 locais[__builtin_ctz(mascara)].pontuacao;
+        }
+        
+        return pontuacao;
+    }
     
-    // Tabela DP: dp[mascara][ultimo] = menor custo para visitar os nós 
-    // representados pela máscara, terminando no nó 'ultimo'
-    std::vector<std::vector<double>> dp(numEstados, 
-                                        std::vector<double>(n, INFINITO));
-    std::vector<std::vector<int>> predecessor(numEstados, 
-                                              std::vector<int>(n, -1));
+    // No modo horário a transição não é uma soma: cada u avança o próprio
+    // horário. Desempate igual ao dos kernels (primeiro u mínimo). Nenhum
+    // trecho é mais rápido que o fator máximo do perfil, então u cujo
+    // limitante inferior já não melhora o mínimo dispensa a integração.
+    template <typename Custo>
+    int minimoDependenteDoTempo(const Custo* custos, const double* distancias, int n,
+                                const ContextoDP& contexto, double* minimo)
+    {
+        const double horasPorKmMinimo = contexto.relogio->horasPorKmMinimo();
+        double melhor = std::numeric_limits<double>::infinity();
+        int indice = -1;
+        
+        for (int u = 0; u < n; ++u) {
+            if (custos[u] >= TabelaDP<Custo>::INFINITO) continue;
+            
+            const double limitante = static_cast<double>(custos[u]) + distancias[u] * horasPorKmMinimo;
+            if (limitante > melhor + EPSILON) continue;
+            
+            const double chegada = contexto.avancar(static_cast<double>(custos[u]), distancias[u], u);
+            if (chegada < melhor) {
+                melhor = chegada;
+                indice = u;
+            }
+        }
+        
+        *minimo = melhor;
+        return indice;
+    }
     
-    // CASO BASE: Origem S -> primeiro local
+    // TRANSIÇÃO (PULL): calcula todos os estados de uma máscara
+    //
+    // custo[mascara][v] = min sobre u de custo[mascara ^ v][u] + dist[u][v].
+    // Cada estado é escrito apenas pela thread que processa sua máscara. A
+    // redução sobre u fica a cargo do kernel (SIMD ou escalar), que devolve o
+    // primeiro u de custo mínimo, reproduzindo o desempate da formulação push
+    // original. Os custos são acumulados em double e só então gravados na
+    // tabela, de modo que a precisão simples afeta apenas o armazenamento
+    // (sempre arredondado para cima).
+    //
+    // Máscaras anteriores sem nenhum estado finito são puladas: com janelas
+    // de horário apertadas a maior parte da tabela morre cedo.
+    template <typename Custo, typename Kernel>
+    void relaxarMascara(TabelaDP<Custo>& tabela,
+                        const ContextoDP& contexto,
+                        Kernel kernelMinimo,
+                        int mascara,
+                        ContadoresDP& contadores)
+    {
+        const int n = tabela.quantidadeLocais();
+        Custo* custos = tabela.custosMascara(mascara);
+        uint8_t* predecessores = tabela.predecessoresMascara(mascara);
+        bool viva = false;
+        
+        for (int restantesV = mascara; restantesV; restantesV &= restantesV - 1) {
+            const int v = __builtin_ctz(restantesV);
+            if (!tabela.viva(mascara ^ (1 << v))) continue;  // Estados já valem INFINITO
+            
+            const Custo* custosAnteriores = tabela.custosMascara(mascara ^ (1 << v));
+            contadores.expandidos.somar();
+            
+            // Grafo simétrico: a linha v contém dist[u][v] para todo u
+            const double* distV = contexto.distancias + static_cast<std::size_t>(v) * n;
+            
+            double melhorCusto;
+            int melhorU;
+            if (contexto.relogio) {
+                melhorU = minimoDependenteDoTempo(custosAnteriores, distV, n, contexto, &melhorCusto);
+                melhorCusto = contexto.visitar(v, melhorCusto);
+            } else {
+                melhorU = kernelMinimo(custosAnteriores, distV, n, &melhorCusto);
+            }
+            
+            // Verifica orçamento
+            if (melhorCusto > contexto.orcamento + EPSILON) {
+                custos[v] = TabelaDP<Custo>::INFINITO;
+                predecessores[v] = TabelaDP<Custo>::SEM_PREDECESSOR;
+                contadores.podados.somar();
+            } else {
+                custos[v] = TabelaDP<Custo>::arredondarParaCima(melhorCusto);
+                predecessores[v] = static_cast<uint8_t>(melhorU);
+                viva = true;
+            }
+        }
+        
+        if (viva) tabela.marcarViva(mascara);
+    }
     
-    for (int i = 0; i < n; ++i) {
-        const double distInicial = calcularDistanciaParaOrigem(i, params);
+    // RECUPERAÇÃO FUNDIDA: avalia a volta para S dos estados de uma máscara
+    // logo após calculá-los, enquanto a linha ainda está no cache
+    template <typename Custo>
+    void avaliarFechamentos(const TabelaDP<Custo>& tabela,
+                            const ContextoDP& contexto,
+                            int mascara,
+                            MelhorEstadoDP& melhor)
+    {
+        const Custo* custos = tabela.custosMascara(mascara);
+        const std::vector<double>& distOrigem = *contexto.distOrigem;
         
-        if (distInicial <= orcamentoKm + EPSILON) {
-            dp[1 << i][i] = distInicial;
+        for (int restantes = mascara; restantes; restantes &= restantes - 1) {
+            const int u = __builtin_ctz(restantes);
+            if (custos[u] >= TabelaDP<Custo>::INFINITO) continue;
+            
+            // Adicionar custo de volta para origem
+            const double custoTotal = contexto.avancar(static_cast<double>(custos[u]), distOrigem[u], u);
+            
+            // VALIDAÇÃO CRÍTICA: Verifica se cabe no orçamento
+            if (custoTotal > contexto.orcamento + EPSILON) continue;
+            
+            MelhorEstadoDP candidato;
+            candidato.pontuacao = contexto.pontuacaoMascara[mascara];
+            candidato.custoTotal = custoTotal;
+            candidato.mascara = mascara;
+            candidato.ultimo = u;
+            
+            if (candidato.melhorQue(melhor)) {
+                melhor = candidato;
+            }
         }
     }
     
-    // TRANSIÇÕES: Held-Karp
+    // Kernel de redução adequado ao tipo de custo armazenado
+    inline KernelMinimoDouble selecionarKernel(const KernelsDP& kernels, double*) {
+        return kernels.minimoDouble;
+    }
     
-    for (int mascara = 1; mascara < numEstados; ++mascara) {
-        for (int u = 0; u < n; ++u) {
-            // u não está na máscara atual
-            if (!(mascara & (1 << u))) continue;
-            
-            const double custoAtual = dp[mascara][u];
-            if (custoAtual >= INFINITO) continue;
+    inline KernelMinimoFloat selecionarKernel(const KernelsDP& kernels, float*) {
+        return kernels.minimoFloat;
+    }
+    
+    // VARREDURA SEQUENCIAL em ordem crescente de máscara
+    // (mascara ^ v < mascara, logo a máscara anterior já está pronta)
+    //
+    // avaliador(idThread, mascara) é chamado logo após cada máscara ficar
+    // pronta; é ele quem decide o que extrair da linha (melhor estado,
+    // fechamento por máscara, ...). Retorna false se a Interrupcao parou a
+    // varredura; as máscaras já avaliadas continuam válidas. Os contadores
+    // da varredura são somados em 'contadores'.
+    template <typename Custo, typename Avaliador>
+    bool executarVarreduraSequencial(TabelaDP<Custo>& tabela,
+                                     const ContextoDP& contexto,
+                                     const KernelsDP& kernels,
+                                     Avaliador& avaliador,
+                                     ContadoresDP& contadores)
+    {
+        const auto kernelMinimo = selecionarKernel(kernels, static_cast<Custo*>(nullptr));
+        const int numEstados = 1 << tabela.quantidadeLocais();
+        
+        for (int mascara = 1; mascara < numEstados; ++mascara) {
+            if (mascara % MASCARAS_POR_VERIFICACAO == 0 && interrompida(contexto.interrupcao)) {
+                return false;
+            }
             
-            // Tentar adicionar nó v
-            for (int v = 0; v < n; ++v) {
-                // v já visitado
-                if (mascara & (1 << v)) continue;
+            // Máscaras de um único bit são o caso base
+            if (mascara & (mascara - 1)) {
+                relaxarMascara(tabela, contexto, kernelMinimo, mascara, contadores);
+            }
+            avaliador(0, mascara);
+        }
+        return true;
+    }
+    
+    // VARREDURA PARALELA por camadas de popcount
+    //
+    // Máscaras com o mesmo número de bits dependem apenas da camada anterior,
+    // então cada camada é dividida em blocos distribuídos dinamicamente entre
+    // as threads, com uma barreira entre camadas. A Interrupcao é consultada
+    // ao fim de cada camada; a decisão de parar depois da camada k só é
+    // escrita antes da barreira k e só é lida depois dela, então todas as
+    // threads param na mesma camada.
+    template <typename Custo, typename Avaliador>
+    bool executarVarreduraParalela(TabelaDP<Custo>& tabela,
+                                   const ContextoDP& contexto,
+                                   const KernelsDP& kernels,
+                                   int numThreads,
+                                   Avaliador& avaliador,
+                                   ContadoresDP& contadores)
+    {
+        ArenaTrabalho& arena = EspacoTrabalho::daThread().arena;
+        ArenaTrabalho::Escopo escopo(arena);
+        
+        constexpr int TAMANHO_BLOCO = 256;
+        
+        const auto kernelMinimo = selecionarKernel(kernels, static_cast<Custo*>(nullptr));
+        const int n = tabela.quantidadeLocais();
+        const int numEstados = 1 << n;
+        
+        // Máscaras ordenadas por popcount (counting sort)
+        int* inicioCamada = arena.alocar<int>(n + 2);
+        std::fill_n(inicioCamada, n + 2, 0);
+        for (int mascara = 0; mascara < numEstados; ++mascara) {
+            ++inicioCamada[__builtin_popcount(mascara) + 1];
+        }
+        for (int k = 1; k <= n + 1; ++k) {
+            inicioCamada[k] += inicioCamada[k - 1];
+        }
+        
+        int* mascarasOrdenadas = arena.alocar<int>(numEstados);
+        int* posicao = arena.alocar<int>(n + 1);
+        std::copy_n(inicioCamada, n + 1, posicao);
+        for (int mascara = 0; mascara < numEstados; ++mascara) {
+            mascarasOrdenadas[posicao[__builtin_popcount(mascara)]++] = mascara;
+        }
+        
+        // Um contador de blocos por camada evita reiniciar contadores entre barreiras
+        std::atomic<int>* proximoBloco = arena.alocar<std::atomic<int>>(n + 1);
+        std::atomic<bool>* pararAposCamada = arena.alocar<std::atomic<bool>>(n + 1);
+        for (int k = 0; k <= n; ++k) {
+            proximoBloco[k].store(0, std::memory_order_relaxed);
+            pararAposCamada[k].store(false, std::memory_order_relaxed);
+        }
+        
+        Barreira barreira(numThreads);
+        ContadoresDP* contadoresPorThread = arena.alocar<ContadoresDP>(numThreads);
+        
+        executarEmParalelo(numThreads, [&](int idThread) {
+            for (int k = 1; k <= n; ++k) {
+                const int inicio = inicioCamada[k];
+                const int fim = inicioCamada[k + 1];
                 
-                const double custoTransicao = distanciasKm[u][v];
-                const double novoCusto = custoAtual + custoTransicao;
+                while (true) {
+                    const int bloco = proximoBloco[k].fetch_add(1, std::memory_order_relaxed);
+                    const int primeiro = inicio + bloco * TAMANHO_BLOCO;
+                    if (primeiro >= fim) break;
+                    
+                    const int ultimo = std::min(fim, primeiro + TAMANHO_BLOCO);
+                    for (int i = primeiro; i < ultimo; ++i) {
+                        const int mascara = mascarasOrdenadas[i];
+                        if (k > 1) {
+                            relaxarMascara(tabela, contexto, kernelMinimo, mascara,
+                                           contadoresPorThread[idThread]);
+                        }
+                        avaliador(idThread, mascara);
+                    }
+                }
                 
-                // Verifica orçamento
-                if (novoCusto > orcamentoKm + EPSILON) continue;
+                if (k < n && interrompida(contexto.interrupcao)) {
+                    pararAposCamada[k].store(true, std::memory_order_relaxed);
+                }
                 
-                const int novaMascara = mascara | (1 << v);
+                barreira.aguardar();
                 
-                // Atualiza se encontrou caminho melhor
-                if (novoCusto < dp[novaMascara][v]) {
-                    dp[novaMascara][v] = novoCusto;
-                    predecessor[novaMascara][v] = u;
+                if (pararAposCamada[k].load(std::memory_order_relaxed)) break;
+            }
+        });
+        
+        for (int t = 0; t < numThreads; ++t) {
+            contadores.somar(contadoresPorThread[t]);
+        }
+        
+        for (int k = 1; k < n; ++k) {
+            if (pararAposCamada[k].load(std::memory_order_relaxed)) return false;
+        }
+        return true;
+    }
+    
+    template <typename Custo, typename Avaliador>
+    bool executarVarredura(TabelaDP<Custo>& tabela,
+                           const ContextoDP& contexto,
+                           const OpcoesDP& opcoes,
+                           Avaliador& avaliador,
+                           ContadoresDP& contadores)
+    {
+        const KernelsDP& kernels = opcoes.usarSimd ? kernelsDPDetectados() : kernelsDPEscalares();
+        const int numThreads = std::min(resolverNumeroThreads(opcoes.numThreads),
+                                        1 << tabela.quantidadeLocais());
+        
+        if (numThreads > 1) {
+            return executarVarreduraParalela(tabela, contexto, kernels, numThreads, avaliador, contadores);
+        }
+        return executarVarreduraSequencial(tabela, contexto, kernels, avaliador, contadores);
+    }
+    
+    // Mantém o melhor estado fechado de cada thread; a redução final usa a
+    // mesma ordem total da varredura sequencial
+    template <typename Custo>
+    struct AvaliadorMelhorEstado {
+        const TabelaDP<Custo>& tabela;
+        const ContextoDP& contexto;
+        MelhorEstadoDP* melhorPorThread;
+        int numThreads;
+        
+        void operator()(int idThread, int mascara) {
+            avaliarFechamentos(tabela, contexto, mascara, melhorPorThread[idThread]);
+        }
+        
+        MelhorEstadoDP melhor() const {
+            MelhorEstadoDP melhorGeral;
+            for (int t = 0; t < numThreads; ++t) {
+                if (melhorPorThread[t].melhorQue(melhorGeral)) {
+                    melhorGeral = melhorPorThread[t];
                 }
             }
+            return melhorGeral;
+        }
+    };
+    
+    // Guarda, para cada máscara, o fechamento mais barato (volta para S) e o
+    // último local correspondente. Cada máscara é escrita por uma só thread.
+    template <typename Custo>
+    struct AvaliadorFechamentoMascara {
+        const TabelaDP<Custo>& tabela;
+        const ContextoDP& contexto;
+        std::vector<double> custoFechamento;
+        std::vector<uint8_t> ultimoFechamento;
+        
+        void operator()(int, int mascara) {
+            const Custo* custos = tabela.custosMascara(mascara);
+            const std::vector<double>& distOrigem = *contexto.distOrigem;
+            
+            double melhorCusto = INFINITO;
+            uint8_t melhorUltimo = TabelaDP<Custo>::SEM_PREDECESSOR;
+            
+            for (int restantes = mascara; restantes; restantes &= restantes - 1) {
+                const int u = __builtin_ctz(restantes);
+                if (custos[u] >= TabelaDP<Custo>::INFINITO) continue;
+                
+                const double custoTotal = contexto.avancar(static_cast<double>(custos[u]), distOrigem[u], u);
+                if (custoTotal < melhorCusto) {
+                    melhorCusto = custoTotal;
+                    melhorUltimo = static_cast<uint8_t>(u);
+                }
+            }
+            
+            custoFechamento[mascara] = melhorCusto;
+            ultimoFechamento[mascara] = melhorUltimo;
+        }
+    };
+    
+    // Segue os predecessores a partir de (mascara, ultimo) até a origem
+    template <typename Custo>
+    std::vector<int> reconstruirRota(const TabelaDP<Custo>& tabela, int mascara, int ultimo) {
+        std::vector<int> rota;
+        rota.reserve(__builtin_popcount(mascara));
+        int atual = ultimo;
+        
+        while (atual != -1) {
+            rota.push_back(atual);
+            const uint8_t anterior = tabela.predecessoresMascara(mascara)[atual];
+            mascara ^= (1 << atual);
+            atual = (anterior == TabelaDP<Custo>::SEM_PREDECESSOR) ? -1 : anterior;
+        }
+        
+        std::reverse(rota.begin(), rota.end());
+        return rota;
+    }
+    
+    // Custo recalculado em double na mesma ordem de acumulação da DP;
+    // com precisão simples isso elimina o arredondamento da tabela
+    double calcularCustoRota(const ContextoDP& contexto, const std::vector<int>& rota) {
+        const std::vector<double>& distOrigem = *contexto.distOrigem;
+        const std::size_t n = contexto.distOrigem->size();
+        
+        double custo = distOrigem[rota.front()];
+        for (std::size_t i = 1; i < rota.size(); ++i) {
+            custo += contexto.distancias[static_cast<std::size_t>(rota[i - 1]) * n + rota[i]];
+        }
+        return custo + distOrigem[rota.back()];
+    }
+    
+    ContextoDP criarContextoDP(const std::vector<Local>& locais,
+                               const GrafoDistancias& grafo,
+                               const std::vector<double>& distOrigem,
+                               double orcamento,
+                               ArenaTrabalho& arena)
+    {
+        const int n = static_cast<int>(locais.size());
+        
+        ContextoDP contexto;
+        contexto.distOrigem = &distOrigem;
+        contexto.orcamento = orcamento;
+        contexto.pontuacaoMascara = construirPontuacaoMascaras(locais, arena);
+        
+        // Matriz de distâncias linearizada (linha u contígua) para o laço interno
+        double* distancias = arena.alocar<double>(static_cast<std::size_t>(n) * n);
+        for (int u = 0; u < n; ++u) {
+            for (int v = 0; v < n; ++v) {
+                distancias[static_cast<std::size_t>(u) * n + v] = grafo.distancia(u, v);
+            }
+        }
+        contexto.distancias = distancias;
+        
+        return contexto;
+    }
+    
+    // CASO BASE: Origem S -> primeiro local
+    template <typename Custo>
+    void prepararTabela(TabelaDP<Custo>& tabela, const ContextoDP& contexto) {
+        const int n = static_cast<int>(contexto.distOrigem->size());
+        tabela.preparar(n);
+        
+        for (int i = 0; i < n; ++i) {
+            const double chegada = contexto.avancar(contexto.custoInicial, (*contexto.distOrigem)[i], -1);
+            const double custoInicial = contexto.visitar(i, chegada);
+            
+            if (custoInicial <= contexto.orcamento + EPSILON) {
+                tabela.custosMascara(1 << i)[i] = TabelaDP<Custo>::arredondarParaCima(custoInicial);
+                tabela.marcarViva(1 << i);
+            }
+        }
+    }
+    
+    // Tabelas que a thread guardou de consultas anteriores. Na entrada, com
+    // teto, a da outra precisão e uma maior que o teto são liberadas para não
+    // somarem à desta; na saída (inclusive por exceção), só fica o que cabe
+    // em opcoes.limiteRetencao()
+    class RetencaoTabelas {
+    public:
+        RetencaoTabelas(EspacoTrabalho& espacoThread, const OpcoesDP& opcoes)
+            : espaco(espacoThread), limite(opcoes.limiteRetencao()) {
+            if (opcoes.memoriaMaximaBytes == 0) return;
+            
+            if (opcoes.precisaoSimples) {
+                espaco.tabelaDupla.liberar();
+                if (espaco.tabelaSimples.bytesReservados() > opcoes.memoriaMaximaBytes) espaco.tabelaSimples.liberar();
+            } else {
+                espaco.tabelaSimples.liberar();
+                if (espaco.tabelaDupla.bytesReservados() > opcoes.memoriaMaximaBytes) espaco.tabelaDupla.liberar();
+            }
+        }
+        ~RetencaoTabelas() { espaco.limitarTabelas(limite); }
+        
+        RetencaoTabelas(const RetencaoTabelas&) = delete;
+        RetencaoTabelas& operator=(const RetencaoTabelas&) = delete;
+        
+    private:
+        EspacoTrabalho& espaco;
+        const std::size_t limite;
+    };
+}
+
+// Tabela mais os vetores de 2^n inteiros (pontuação por máscara e ordem
+// das camadas da varredura paralela)
+std::size_t OrienteeringProblemSolver::memoriaNecessariaDP(int n, const OpcoesDP& opcoes) {
+    const std::size_t tabela = opcoes.precisaoSimples ? TabelaDP<float>::bytesNecessarios(n)
+                                                      : TabelaDP<double>::bytesNecessarios(n);
+    return tabela + 2 * (std::size_t(1) << n) * sizeof(int);
+}
+
+void OrienteeringProblemSolver::prepararEspacoTrabalho(bool comTabelaDP, const OpcoesDP& opcoes) const {
+    constexpr std::size_t FOLGA_BYTES = 4096;  // Alinhamento e vetores por thread
+    
+    const int n = static_cast<int>(locais.size());
+    const std::size_t locaisN = static_cast<std::size_t>(n);
+    const bool dpDensa = n <= MAX_LOCAIS_DP;
+    
+    // Dois relógios (despacho e solver) mais o guloso, ou a matriz e os
+    // vetores por máscara da DP
+    std::size_t bytes = 2 * locaisN * sizeof(double) + locaisN * (sizeof(bool) + sizeof(int));
+    if (dpDensa) {
+        bytes = std::max(bytes, 2 * locaisN * sizeof(double) + locaisN * locaisN * sizeof(double) +
+                                2 * (std::size_t(1) << n) * sizeof(int));
+    }
+    
+    EspacoTrabalho& espaco = EspacoTrabalho::daThread();
+    espaco.arena.reservar(bytes + FOLGA_BYTES);
+    
+    if (!comTabelaDP || !dpDensa) return;
+    
+    // Uma tabela acima da retenção seria liberada ao fim da primeira DP
+    const std::size_t bytesTabela = opcoes.precisaoSimples ? TabelaDP<float>::bytesNecessarios(n)
+                                                           : TabelaDP<double>::bytesNecessarios(n);
+    const bool cabe = (opcoes.memoriaMaximaBytes == 0 || memoriaNecessariaDP(n, opcoes) <= opcoes.memoriaMaximaBytes) &&
+                      bytesTabela <= opcoes.limiteRetencao();
+    if (cabe) {
+        if (opcoes.precisaoSimples) {
+            espaco.tabelaSimples.preparar(n);
+        } else {
+            espaco.tabelaDupla.preparar(n);
         }
     }
+}
+
+ResultadoSolucao OrienteeringProblemSolver::resolverProgramacaoDinamica(const ParametrosViagem& params,
+                                                                      const OpcoesDP& opcoes) {
+    auto inicioTempo = std::chrono::high_resolution_clock::now();
+    CronometroFases cronometro;
+    
+    saida() << "\nIniciando Programacao Dinamica (Solucao otima)...\n";
+    
+    ResultadoSolucao resultado;
+    
+    // Validações
+    if (!params.validar()) {
+        erros() << "Parametros de viagem invalidos.\n";
+        return resultado;
+    }
+    
+    validarDados();
+    
+    const int n = static_cast<int>(locais.size());
+    const double orcamentoKm = params.orcamentoKm();
+    
+    EspacoTrabalho& espaco = EspacoTrabalho::daThread();
+    const RetencaoTabelas retencao(espaco, opcoes);
+    
+    // Com teto de memória, tabelas que não cabem viram busca em feixe
+    if (opcoes.memoriaMaximaBytes > 0 &&
+        (n > MAX_LOCAIS_DP || memoriaNecessariaDP(n, opcoes) > opcoes.memoriaMaximaBytes)) {
+        return resolverBuscaFeixe(params, opcoes.memoriaMaximaBytes);
+    }
+    
+    if (n > MAX_LOCAIS_DP) {
+        erros() << "Programacao Dinamica suporta ate " << MAX_LOCAIS_DP 
+                << " locais (" << n << " carregados). Use resolverBranchAndBound.\n";
+        return resultado;
+    }
+    
+    // Vetores da consulta e tabela vêm do espaço de trabalho da thread
+    ArenaTrabalho::Escopo escopo(espaco.arena);
     
-    // RECUPERAÇÃO DA MELHOR SOLUÇÃO (incluindo volta para S)
+    // Distâncias S -> i calculadas uma única vez (ou reaproveitadas do cache)
+    const auto ponteiroDistOrigem = obterDistanciasOrigem(params);
+    const std::vector<double>& distOrigem = *ponteiroDistOrigem;
     
-    int melhorPontuacao = 0;
-    double melhorCustoTotal = INFINITO;
-    int melhorMascara = 0;
-    int melhorUltimo = -1;
+    // No modo horário o orçamento é de relógio: volta a S até o limite
+    const bool dependenteDoTempo = modoHorario();
+    const RelogioViagem relogio(perfilVelocidade, locais, zonaLocal, params, distOrigem);
+    auto distancia = [&](int a, int b) { return grafo.distancia(a, b); };
     
-    // Primeiro: verificar se É POSSÍVEL chegar em algum local e voltar
+    // Verificar se É POSSÍVEL chegar em algum local e voltar antes de
+    // alocar a tabela
     bool existeSolucaoViavel = false;
     for (int i = 0; i < n; ++i) {
-        double custoIdaVolta = 2.0 * calcularDistanciaParaOrigem(i, params);
-        if (custoIdaVolta <= orcamentoKm + EPSILON) {
+        const bool cabe = dependenteDoTempo
+            ? relogio.simularRota({i}, distOrigem, distancia) <= relogio.limite() + EPSILON
+            : 2.0 * distOrigem[i] <= orcamentoKm + EPSILON;
+        if (cabe) {
             existeSolucaoViavel = true;
             break;
         }
     }
     
     if (!existeSolucaoViavel) {
-        std::cout << "Orcamento insuficiente para visitar qualquer local (ida + volta).\n";
+        saida() << "Orcamento insuficiente para visitar qualquer local (ida + volta).\n";
         auto fimTempo = std::chrono::high_resolution_clock::now();
         resultado.tempoExecucaoMs = std::chrono::duration_cast<std::chrono::milliseconds>(
             fimTempo - inicioTempo).count();
         return resultado;
     }
     
-    for (int mascara = 1; mascara < numEstados; ++mascara) {
-        const int pontuacaoAtual = calcularPontuacaoMascara(mascara);
-        
-        for (int u = 0; u < n; ++u) {
-            if (dp[mascara][u] >= INFINITO) continue;
-            
-            // Adicionar custo de volta para origem
-            const double custoVolta = calcularDistanciaParaOrigem(u, params);
-            const double custoTotal = dp[mascara][u] + custoVolta;
-            
-            // VALIDAÇÃO CRÍTICA: Verifica se cabe no orçamento
-            if (custoTotal > orcamentoKm + EPSILON) continue;
-            
-            // Critério de otimização: maximizar pontuação, 
-            // desempate por menor custo
-            if (pontuacaoAtual > melhorPontuacao ||
-                (pontuacaoAtual == melhorPontuacao && 
-                 custoTotal < melhorCustoTotal)) 
-            {
-                melhorPontuacao = pontuacaoAtual;
-                melhorCustoTotal = custoTotal;
-                melhorMascara = mascara;
-                melhorUltimo = u;
-            }
-        }
+    ContextoDP contexto = criarContextoDP(locais, grafo, distOrigem,
+                                          dependenteDoTempo ? relogio.limite() : orcamentoKm, espaco.arena);
+    if (dependenteDoTempo) {
+        contexto.relogio = &relogio;
+        contexto.custoInicial = relogio.partida();
     }
+    contexto.interrupcao = params.interrupcao;
     
-    // RECONSTRUÇÃO DA ROTA
+    // Prazo já vencido: nem aloca a tabela
+    if (interrompida(params.interrupcao)) {
+        saida() << "Prazo esgotado antes da Programacao Dinamica.\n";
+        resultado.interrompida = true;
+        auto fimTempo = std::chrono::high_resolution_clock::now();
+        resultado.tempoExecucaoMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            fimTempo - inicioTempo).count();
+        return resultado;
+    }
     
-    if (melhorUltimo != -1) {
-        std::vector<int> rota;
-        int mascara = melhorMascara;
-        int atual = melhorUltimo;
+    // Tabela DP: custo[mascara][ultimo] = menor custo para visitar os nós 
+    // representados pela máscara, terminando no nó 'ultimo'
+    auto executar = [&](auto& tabela) {
+        using Custo = typename std::remove_reference_t<decltype(tabela)>::TipoCusto;
         
-        while (atual != -1) {
-            rota.push_back(atual);
-            const int anterior = predecessor[mascara][atual];
-            mascara ^= (1 << atual);
-            atual = anterior;
+        prepararTabela(tabela, contexto);
+        resultado.metricas.preparacaoNs = cronometro.marcar();
+        
+        // TRANSIÇÕES + RECUPERAÇÃO DA MELHOR SOLUÇÃO (incluindo volta para S)
+        // numa única passada pela tabela
+        
+        const int numThreads = std::max(1, resolverNumeroThreads(opcoes.numThreads));
+        AvaliadorMelhorEstado<Custo> avaliador{tabela, contexto,
+            espaco.arena.alocar<MelhorEstadoDP>(numThreads), numThreads};
+        // Interrompida, a varredura ainda deixa a melhor rota das máscaras já
+        // avaliadas, que é viável mas sem garantia de otimalidade
+        ContadoresDP contadores;
+        resultado.interrompida = !executarVarredura(tabela, contexto, opcoes, avaliador, contadores);
+        resultado.metricas.transicoesNs = cronometro.marcar();
+        resultado.metricas.estadosExpandidos = contadores.expandidos.total();
+        resultado.metricas.transicoesPodadas = contadores.podados.total();
+        
+        const MelhorEstadoDP melhor = avaliador.melhor();
+        resultado.metricas.recuperacaoNs = cronometro.marcar();
+        if (resultado.interrompida) {
+            saida() << "Prazo esgotado: retornando a melhor rota encontrada ate aqui.\n";
         }
         
-        std::reverse(rota.begin(), rota.end());
+        // RECONSTRUÇÃO DA ROTA
+        
+        if (melhor.ultimo == -1) {
+            saida() << "Nenhuma rota valida encontrada dentro do orçamento de " 
+                    << params.orcamentoHoras << " horas (" << orcamentoKm << " km).\n";
+            return;
+        }
+        
+        std::vector<int> rota = reconstruirRota(tabela, melhor.mascara, melhor.ultimo);
+        const double custoRota = calcularCustoRota(contexto, rota);
+        const double chegadaRota = dependenteDoTempo ? relogio.simularRota(rota, distOrigem, distancia) : 0.0;
         
         // VALIDAÇÃO FINAL: Verificar se a rota respeita o orçamento
-        if (melhorCustoTotal <= orcamentoKm + EPSILON) {
-            resultado.rota = rota;
-            resultado.pontuacaoTotal = melhorPontuacao;
-            resultado.custoKm = melhorCustoTotal;
-            resultado.tempoHoras = melhorCustoTotal / params.velocidadeKmh;
+        const bool cabe = dependenteDoTempo ? chegadaRota <= relogio.limite() + EPSILON
+                                            : custoRota <= orcamentoKm + EPSILON;
+        if (cabe) {
+            resultado.rota = std::move(rota);
+            resultado.pontuacaoTotal = melhor.pontuacao;
+            resultado.custoKm = custoRota;
+            resultado.tempoHoras = dependenteDoTempo ? chegadaRota - params.horaPartida
+                                                     : custoRota / params.velocidadeKmh;
             resultado.solucaoValida = true;
+            resultado.otimoComprovado = !resultado.interrompida;
         } else {
-            std::cout << "Solucao encontrada excede orçamento. Retornando vazio.\n";
+            saida() << "Solucao encontrada excede orçamento. Retornando vazio.\n";
         }
+        resultado.metricas.reconstrucaoNs = cronometro.marcar();
+    };
+    
+    if (opcoes.precisaoSimples) {
+        executar(espaco.tabelaSimples);
     } else {
-        std::cout << "Nenhuma rota valida encontrada dentro do orçamento de " 
-                  << params.orcamentoHoras << " horas (" << orcamentoKm << " km).\n";
+        executar(espaco.tabelaDupla);
     }
     
     // Tempo de execução
@@ -169,3 +722,144 @@ ResultadoSolucao OrienteeringProblemSolver::resolverProgramacaoDinamica(const Pa
     
     return resultado;
 }
+
+FronteiraPareto OrienteeringProblemSolver::construirFronteiraPareto(double latitudePartida,
+                                                                     double longitudePartida,
+                                                                     const OpcoesDP& opcoes) {
+    saida() << "\nConstruindo fronteira de Pareto (Programacao Dinamica)...\n";
+    
+    FronteiraPareto fronteira;
+    fronteira.latitudePartida = latitudePartida;
+    fronteira.longitudePartida = longitudePartida;
+    
+    validarDados();
+    
+    // Os custos da fronteira são km: não há um horário de partida a seguir
+    if (recusaModoHorario("A fronteira de Pareto")) {
+        return fronteira;
+    }
+    
+    const int n = static_cast<int>(locais.size());
+    if (n > MAX_LOCAIS_DP) {
+        erros() << "Programacao Dinamica suporta ate " << MAX_LOCAIS_DP 
+                << " locais (" << n << " carregados). Use resolverBranchAndBound.\n";
+        return fronteira;
+    }
+    
+    // Só a origem importa para o cache; orçamento e velocidade são ignorados
+    ParametrosViagem origem{latitudePartida, longitudePartida, 0.0, 0.0};
+    const auto ponteiroDistOrigem = obterDistanciasOrigem(origem);
+    
+    // Sem poda de orçamento: custo[mascara][ultimo] é o custo mínimo exato.
+    // Com poda, estados dentro do orçamento teriam o mesmo valor (os prefixos
+    // de um caminho nunca custam mais que ele), então cada orçamento recebe
+    // a mesma resposta que resolverProgramacaoDinamica daria.
+    EspacoTrabalho& espaco = EspacoTrabalho::daThread();
+    const RetencaoTabelas retencao(espaco, opcoes);
+    ArenaTrabalho::Escopo escopo(espaco.arena);
+    const ContextoDP contexto = criarContextoDP(locais, grafo, *ponteiroDistOrigem, INFINITO, espaco.arena);
+    const int numEstados = 1 << n;
+    
+    auto executar = [&](auto& tabela) {
+        using Custo = typename std::remove_reference_t<decltype(tabela)>::TipoCusto;
+        
+        prepararTabela(tabela, contexto);
+        
+        AvaliadorFechamentoMascara<Custo> avaliador{tabela, contexto,
+            std::vector<double>(numEstados, INFINITO),
+            std::vector<uint8_t>(numEstados, TabelaDP<Custo>::SEM_PREDECESSOR)};
+        ContadoresDP contadores;
+        executarVarredura(tabela, contexto, opcoes, avaliador, contadores);
+        
+        // Máscaras por custo crescente; no mesmo custo, maior pontuação e
+        // menor máscara primeiro (mesmo desempate da DP)
+        std::vector<int> ordem;
+        ordem.reserve(numEstados);
+        for (int mascara = 1; mascara < numEstados; ++mascara) {
+            if (avaliador.custoFechamento[mascara] < INFINITO) ordem.push_back(mascara);
+        }
+        
+        std::sort(ordem.begin(), ordem.end(), [&](int a, int b) {
+            const double custoA = avaliador.custoFechamento[a];
+            const double custoB = avaliador.custoFechamento[b];
+            if (custoA != custoB) return custoA < custoB;
+            const int pontuacaoA = contexto.pontuacaoMascara[a];
+            const int pontuacaoB = contexto.pontuacaoMascara[b];
+            if (pontuacaoA != pontuacaoB) return pontuacaoA > pontuacaoB;
+            return a < b;
+        });
+        
+        // Um ponto só entra se melhora a pontuação de todos os mais baratos
+        int melhorPontuacao = 0;
+        for (int mascara : ordem) {
+            const int pontuacao = contexto.pontuacaoMascara[mascara];
+            if (pontuacao <= melhorPontuacao) continue;
+            
+            PontoPareto ponto;
+            ponto.pontuacao = pontuacao;
+            ponto.rota = reconstruirRota(tabela, mascara, avaliador.ultimoFechamento[mascara]);
+            ponto.custoKm = calcularCustoRota(contexto, ponto.rota);
+            fronteira.pontos.push_back(std::move(ponto));
+            
+            melhorPontuacao = pontuacao;
+        }
+    };
+    
+    if (opcoes.precisaoSimples) {
+        executar(espaco.tabelaSimples);
+    } else {
+        executar(espaco.tabelaDupla);
+    }
+    
+    saida() << "Pontos na fronteira: " << fronteira.pontos.size() << "\n";
+    
+    return fronteira;
+}
+
+ResultadoSolucao OrienteeringProblemSolver::consultarFronteira(const FronteiraPareto& fronteira,
+                                                               const ParametrosViagem& params) const {
+    auto inicioTempo = std::chrono::high_resolution_clock::now();
+    
+    ResultadoSolucao resultado;
+    
+    if (!params.validar()) {
+        erros() << "Parametros de viagem invalidos.\n";
+        return resultado;
+    }
+    
+    if (params.latitudePartida != fronteira.latitudePartida ||
+        params.longitudePartida != fronteira.longitudePartida) {
+        erros() << "Consulta parte de uma origem diferente da fronteira.\n";
+        return resultado;
+    }
+    
+    // Fronteira construída antes de o modelo mudar
+    if (recusaModoHorario("A fronteira de Pareto")) {
+        return resultado;
+    }
+    
+    const double orcamentoKm = params.orcamentoKm();
+    
+    // Último ponto que cabe no orçamento = maior pontuação viável
+    auto it = std::upper_bound(fronteira.pontos.begin(), fronteira.pontos.end(), orcamentoKm + EPSILON,
+        [](double limite, const PontoPareto& ponto) { return limite < ponto.custoKm; });
+    
+    if (it != fronteira.pontos.begin()) {
+        const PontoPareto& ponto = *std::prev(it);
+        resultado.rota = ponto.rota;
+        resultado.pontuacaoTotal = ponto.pontuacao;
+        resultado.custoKm = ponto.custoKm;
+        resultado.tempoHoras = ponto.custoKm / params.velocidadeKmh;
+        resultado.solucaoValida = true;
+        resultado.otimoComprovado = true;
+    } else {
+        saida() << "Nenhuma rota valida encontrada dentro do orçamento de " 
+                << params.orcamentoHoras << " horas (" << orcamentoKm << " km).\n";
+    }
+    
+    auto fimTempo = std::chrono::high_resolution_clock::now();
+    resultado.tempoExecucaoMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        fimTempo - inicioTempo).count();
+    
+    return resultado;
+}
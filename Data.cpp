@@ -1,150 +1,258 @@
 #include "Solver.h"
-#include <fstream>
-#include <sstream>
-#include <stdexcept>
-#include <iostream>
-#include <iomanip>
-#include <cmath>
+#include "ArquivoMapeado.h"
+#include "Haversine.h"
 #include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
 
-// CONSTANTES
+// CARREGAMENTO DE DADOS
+//
+// O CSV é mapeado em memória e percorrido uma única vez: linhas e campos são
+// fatias do próprio arquivo, os números são convertidos com std::from_chars
+// (sem locale e sem alocação) e os nomes vão para uma arena contígua.
+//
+// Colunas: ID,Nome,Latitude,Longitude,Pontuacao e, se o cabeçalho as tiver,
+// DuracaoHoras,AberturaHoras,FechamentoHoras (horas decimais desde 0h).
+// Campos de horário vazios ficam sem restrição.
 
 namespace {
-    constexpr double RAIO_TERRA_KM = 6371.0;
-    constexpr int MAX_LOCAIS = 20;
-}
-
-// CÁLCULO DE DISTÂNCIA (FÓRMULA DE HAVERSINE)
-
-double OrienteeringProblemSolver::calcularDistanciaHaversine(double lat1, double lon1, double lat2, double lon2) {
-    auto grausParaRadianos = [](double graus) { return graus * M_PI / 180.0; };
+    constexpr int NUM_CAMPOS = 5;
+    constexpr int NUM_CAMPOS_COM_HORARIO = 8;
+    constexpr const char* NOMES_CAMPOS[NUM_CAMPOS_COM_HORARIO] = {
+        "ID", "Nome", "Latitude", "Longitude", "Pontuacao", "DuracaoHoras", "AberturaHoras", "FechamentoHoras"};
     
-    const double dLat = grausParaRadianos(lat2 - lat1);
-    const double dLon = grausParaRadianos(lon2 - lon1);
-    
-    const double a = std::sin(dLat / 2) * std::sin(dLat / 2) +
-                     std::cos(grausParaRadianos(lat1)) * 
-                     std::cos(grausParaRadianos(lat2)) *
-                     std::sin(dLon / 2) * std::sin(dLon / 2);
+    std::string_view aparar(std::string_view campo) {
+        while (!campo.empty() && (campo.front() == ' ' || campo.front() == '\t')) campo.remove_prefix(1);
+        while (!campo.empty() && (campo.back() == ' ' || campo.back() == '\t' || campo.back() == '\r')) {
+            campo.remove_suffix(1);
+        }
+        return campo;
+    }
     
-    const double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
+    // Aceita espaços nas pontas e '+' inicial, como std::stoi/std::stod
+    template <typename T>
+    bool converterCampo(std::string_view campo, T& valor) {
+        campo = aparar(campo);
+        if (campo.size() > 1 && campo.front() == '+' && campo[1] != '-') campo.remove_prefix(1);
+        
+        const char* fim = campo.data() + campo.size();
+        const auto [ultimo, erro] = std::from_chars(campo.data(), fim, valor);
+        return !campo.empty() && erro == std::errc() && ultimo == fim;
+    }
     
-    return RAIO_TERRA_KM * c;
+    // Campo de horário opcional: vazio mantém o valor padrão
+    bool converterHorario(std::string_view campo, double& valor) {
+        if (aparar(campo).empty()) return true;
+        return converterCampo(campo, valor) && std::isfinite(valor);
+    }
 }
 
-// CARREGAMENTO DE DADOS
-
 void OrienteeringProblemSolver::carregarDados(const std::string& arquivoCsv) {
-    std::ifstream arquivo(arquivoCsv);
+    const ArquivoMapeado arquivo(arquivoCsv);
+    arquivo.leituraSequencial();
     
-    if (!arquivo.is_open()) {
-        throw std::runtime_error("Impossivel abrir o arquivo: " + arquivoCsv);
-    }
-    
-    std::string linha;
+    std::string_view restante(arquivo.dados, arquivo.tamanho);
+    auto proximaLinha = [&restante]() {
+        const std::size_t quebra = restante.find('\n');
+        const std::string_view linha = restante.substr(0, quebra);
+        restante.remove_prefix(quebra == std::string_view::npos ? restante.size() : quebra + 1);
+        return linha;
+    };
     
-    // Ignorar cabeçalho
-    if (!std::getline(arquivo, linha)) {
+    // Cabeçalho: só decide se as colunas de horário existem
+    if (restante.empty()) {
         throw std::runtime_error("Arquivo CSV vazio");
     }
+    const std::string_view cabecalho = proximaLinha();
+    const int camposLidos = (std::count(cabecalho.begin(), cabecalho.end(), ',') + 1 >= NUM_CAMPOS_COM_HORARIO)
+        ? NUM_CAMPOS_COM_HORARIO : NUM_CAMPOS;
     
-    locais.clear();
-    locais.reserve(MAX_LOCAIS);
+    // No máximo um local por linha: reserva única
+    const std::size_t maxLinhas = static_cast<std::size_t>(std::count(restante.begin(), restante.end(), '\n')) + 1;
+    std::vector<Local> carregados;
+    std::vector<std::size_t> inicioNome;
+    std::vector<char> arena;
+    carregados.reserve(maxLinhas);
+    inicioNome.reserve(maxLinhas + 1);
     
-    int linhaAtual = 2; // Linha 1 é o cabeçalho
+    int linhaAtual = 1; // Linha 1 é o cabeçalho
     
-    while (std::getline(arquivo, linha) && locais.size() < MAX_LOCAIS) {
-        std::stringstream ss(linha);
-        std::string campo;
+    while (!restante.empty()) {
+        const std::string_view linha = proximaLinha();
+        ++linhaAtual;
+        if (aparar(linha).empty()) continue;
+        
+        std::string_view campos[NUM_CAMPOS_COM_HORARIO];
+        int numCampos = 0;
+        for (std::string_view resto = linha; numCampos < camposLidos; ) {
+            const std::size_t virgula = resto.find(',');
+            campos[numCampos++] = resto.substr(0, virgula);
+            if (virgula == std::string_view::npos) break;
+            resto.remove_prefix(virgula + 1);
+        }
+        
+        if (numCampos < NUM_CAMPOS) {
+            erros() << "Aviso: Linha " << linhaAtual << " com " << numCampos << " de " << NUM_CAMPOS
+                    << " campos, ignorando.\n";
+            continue;
+        }
+        
         Local local;
+        int campoInvalido = -1;
+        if (!converterCampo(campos[0], local.id)) {
+            campoInvalido = 0;
+        } else if (!converterCampo(campos[2], local.latitude) || !std::isfinite(local.latitude)) {
+            campoInvalido = 2;
+        } else if (!converterCampo(campos[3], local.longitude) || !std::isfinite(local.longitude)) {
+            campoInvalido = 3;
+        } else if (!converterCampo(campos[4], local.pontuacao)) {
+            campoInvalido = 4;
+        } else if (numCampos > 5 && !converterHorario(campos[5], local.duracaoVisitaHoras)) {
+            campoInvalido = 5;
+        } else if (numCampos > 6 && !converterHorario(campos[6], local.aberturaHoras)) {
+            campoInvalido = 6;
+        } else if (numCampos > 7 && !converterHorario(campos[7], local.fechamentoHoras)) {
+            campoInvalido = 7;
+        }
         
-        try {
-            // ID
-            if (!std::getline(ss, campo, ',')) continue;
-            local.id = std::stoi(campo);
-            
-            // Nome
-            if (!std::getline(ss, campo, ',')) continue;
-            local.nome = campo;
-            
-            // Latitude
-            if (!std::getline(ss, campo, ',')) continue;
-            local.latitude = std::stod(campo);
-            
-            // Longitude
-            if (!std::getline(ss, campo, ',')) continue;
-            local.longitude = std::stod(campo);
-            
-            // Pontuação
-            if (!std::getline(ss, campo, ',')) continue;
-            local.pontuacao = std::stoi(campo);
-            
-            // Validação básica
-            if (local.pontuacao < 0) {
-                std::cerr << "Aviso: Pontuacao negativa na linha " << linhaAtual << ", ignorando.\n";
-                continue;
-            }
-            
-            locais.push_back(local);
-            
-        } catch (const std::exception& e) {
-            std::cerr << "Aviso: Erro ao processar linha " << linhaAtual << " (" << e.what() << "), ignorando.\n";
+        if (campoInvalido >= 0) {
+            erros() << "Aviso: Erro ao processar linha " << linhaAtual << " (" << NOMES_CAMPOS[campoInvalido]
+                    << " invalido: '" << aparar(campos[campoInvalido]) << "'), ignorando.\n";
+            continue;
         }
         
-        ++linhaAtual;
+        // Validação básica
+        if (local.pontuacao < 0) {
+            erros() << "Aviso: Pontuacao negativa na linha " << linhaAtual << ", ignorando.\n";
+            continue;
+        }
+        if (local.duracaoVisitaHoras < 0.0 || local.aberturaHoras > local.fechamentoHoras) {
+            erros() << "Aviso: Duracao ou janela de horario invalida na linha " << linhaAtual << ", ignorando.\n";
+            continue;
+        }
+        
+        inicioNome.push_back(arena.size());
+        arena.insert(arena.end(), campos[1].begin(), campos[1].end());
+        carregados.push_back(local);
     }
     
-    if (locais.empty()) {
+    if (carregados.empty()) {
         throw std::runtime_error("Nenhum local valido foi carregado do CSV");
     }
     
-    std::cout << locais.size() << " locais carregados com sucesso.\n";
+    // A arena não cresce mais: os nomes já podem apontar para ela
+    inicioNome.push_back(arena.size());
+    std::vector<std::string_view> nomes(carregados.size());
+    for (std::size_t i = 0; i < carregados.size(); ++i) {
+        nomes[i] = std::string_view(arena.data() + inicioNome[i], inicioNome[i + 1] - inicioNome[i]);
+    }
+    
+    locais = std::move(carregados);
+    nomesLocais = std::move(arena);  // Move de vector preserva o buffer
+    nomesPorLocal = std::move(nomes);
+    cacheOrigem->limpar();
+    atualizarModeloHorario();
+    
+    saida() << locais.size() << " locais carregados com sucesso.\n";
 }
 
 // CONSTRUÇÃO DO GRAFO
 
-void OrienteeringProblemSolver::construirGrafo() {
+void OrienteeringProblemSolver::construirGrafo(int numThreads) {
     validarDados();
     
     const int n = static_cast<int>(locais.size());
-    distanciasKm.assign(n, std::vector<double>(n, 0.0));
+    cacheOrigem->limpar();
     
+    std::vector<double> latitudes(n), longitudes(n);
     for (int i = 0; i < n; ++i) {
-        for (int j = i + 1; j < n; ++j) {
-            const double dist = calcularDistanciaHaversine(
-                locais[i].latitude, locais[i].longitude,
-                locais[j].latitude, locais[j].longitude
-            );
-            
-            distanciasKm[i][j] = distanciasKm[j][i] = dist;  // Grafo simétrico
-        }
+        latitudes[i] = locais[i].latitude;
+        longitudes[i] = locais[i].longitude;
     }
     
-    std::cout << "Grafo construido: " << n << " vertices, " << (n * (n - 1) / 2) << " arestas.\n";
+    grafo.construirDenso(latitudes, longitudes, numThreads);
+    indiceEspacial.construir(locais, RAIO_TERRA_KM);
+    
+    saida() << "Grafo construido: " << n << " vertices, " << (n * (n - 1) / 2) << " arestas.\n";
 }
 
-// FUNÇÕES AUXILIARES
-
-int OrienteeringProblemSolver::calcularPontuacaoMascara(int mascara) const {
-    int pontuacaoTotal = 0;
+void OrienteeringProblemSolver::construirGrafoEsparso(int vizinhosPorLocal, int numThreads) {
+    validarDados();
+    
     const int n = static_cast<int>(locais.size());
+    cacheOrigem->limpar();
     
+    std::vector<double> latitudes(n), longitudes(n);
     for (int i = 0; i < n; ++i) {
-        if (mascara & (1 << i)) {
-            pontuacaoTotal += locais[i].pontuacao;
+        latitudes[i] = locais[i].latitude;
+        longitudes[i] = locais[i].longitude;
+    }
+    
+    // O índice espacial também serve para achar os k vizinhos
+    indiceEspacial.construir(locais, RAIO_TERRA_KM);
+    grafo.construirEsparso(latitudes, longitudes, indiceEspacial, vizinhosPorLocal, numThreads);
+    
+    saida() << "Grafo esparso construido: " << n << " vertices, " << grafo.paresArmazenados()
+            << " arestas armazenadas (" << vizinhosPorLocal << " vizinhos por local).\n";
+}
+
+// MODO HORÁRIO
+
+void OrienteeringProblemSolver::definirPerfilVelocidade(const PerfilVelocidade& perfil) {
+    perfilVelocidade = perfil;
+    atualizarModeloHorario();
+}
+
+void OrienteeringProblemSolver::atualizarModeloHorario() {
+    zonaLocal.assign(locais.size(), 0);
+    restricoesHorario = false;
+    
+    for (std::size_t i = 0; i < locais.size(); ++i) {
+        if (!perfilVelocidade.vazio()) {
+            zonaLocal[i] = perfilVelocidade.zona(locais[i].latitude, locais[i].longitude);
         }
+        restricoesHorario = restricoesHorario || locais[i].possuiRestricaoHorario();
+    }
+}
+
+bool OrienteeringProblemSolver::recusaModoHorario(const char* solver) const {
+    if (!modoHorario()) return false;
+    
+    erros() << solver << " nao segue perfil de velocidade, duracao de visita nem janela de horario. "
+            << "Use a DP, o guloso ou o guloso com busca local.\n";
+    return true;
+}
+
+// FUNÇÕES AUXILIARES
+
+CacheDistanciasOrigem::Distancias OrienteeringProblemSolver::obterDistanciasOrigem(const ParametrosViagem& params) const {
+    auto distancias = cacheOrigem->buscar(params.latitudePartida, params.longitudePartida);
+    if (distancias) {
+        return distancias;
     }
     
-    return pontuacaoTotal;
+    // Uma linha do kernel em lote, com a mesma aritmética das distâncias entre locais
+    auto calculadas = std::make_shared<std::vector<double>>(locais.size());
+    grafo.distanciasDoPonto(params.latitudePartida, params.longitudePartida, calculadas->data());
+    
+    cacheOrigem->inserir(params.latitudePartida, params.longitudePartida, calculadas);
+    return calculadas;
+}
+
+thread_local bool OrienteeringProblemSolver::saidaSuprimidaNaThread = false;
+
+std::ostream& OrienteeringProblemSolver::saida() const {
+    thread_local std::ostream fluxoNulo(nullptr);
+    return (silencioso || saidaSuprimidaNaThread) ? fluxoNulo : std::cout;
 }
 
-double OrienteeringProblemSolver::calcularDistanciaParaOrigem(int indiceLocal, const ParametrosViagem& params) const {
-    return calcularDistanciaHaversine(
-        locais[indiceLocal].latitude,
-        locais[indiceLocal].longitude,
-        params.latitudePartida,
-        params.longitudePartida
-    );
+std::ostream& OrienteeringProblemSolver::erros() const {
+    thread_local std::ostream fluxoNulo(nullptr);
+    return (silencioso || saidaSuprimidaNaThread) ? fluxoNulo : std::cerr;
 }
 
 void OrienteeringProblemSolver::validarDados() const {
@@ -160,9 +268,10 @@ void OrienteeringProblemSolver::exibirLocais() const {
     std::cout << "LOCAIS CARREGADOS\n";
     std::cout << std::string(70, '=') << "\n\n";
     
-    for (const auto& local : locais) {
+    for (std::size_t i = 0; i < locais.size(); ++i) {
+        const Local& local = locais[i];
         std::cout << std::setw(3) << local.id << " | "
-                  << std::left << std::setw(35) << local.nome << " | "
+                  << std::left << std::setw(35) << nomesPorLocal[i] << " | "
                   << std::right << std::setw(6) << local.pontuacao << " pts | "
                   << std::fixed << std::setprecision(6)
                   << "(" << local.latitude << ", " << local.longitude << ")\n";
@@ -200,7 +309,7 @@ void OrienteeringProblemSolver::exibirResultado(const ResultadoSolucao& resultad
         std::cout << "Locais visitados (" << resultado.rota.size() << " locais):\n";
         for (size_t i = 0; i < resultado.rota.size(); ++i) {
             const auto& local = locais[resultado.rota[i]];
-            std::cout << "  " << (i + 1) << ". " << local.nome 
+            std::cout << "  " << (i + 1) << ". " << nomesPorLocal[resultado.rota[i]] 
                      << " (" << local.pontuacao << " pts)\n";
         }
     }
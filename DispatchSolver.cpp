@@ -0,0 +1,225 @@
+#include "Solver.h"
+#include "Paralelismo.h"
+#include "RelogioViagem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+
+// DESPACHO HÍBRIDO POR CONSULTA
+//
+// Os custos de cada solver são estimados a partir das características da
+// consulta, e não medidos: o guloso é linear no catálogo, a DP densa é
+// 2^n · n² independentemente do orçamento e o branch-and-bound acompanha o
+// número de estados (conjunto, último) alcançáveis. Esse número é estimado
+// como num grafo aleatório: com q = fração dos pares de candidatos que cabem
+// juntos numa rota (S -> i -> j -> S no orçamento), um conjunto de k
+// candidatos é viável com probabilidade ~ q^(k(k-1)/2). As constantes de
+// tempo foram medidas numa máquina de referência e são só ponto de partida;
+// o registro de cada decisão traz estimativa e tempo real para ajustá-las.
+
+namespace {
+    constexpr double EPSILON = 1e-9;
+
+    // Acima disso a densidade de pares custa mais que o próprio guloso e a
+    // estimativa de estados perde o sentido: só heurísticas
+    constexpr int MAX_CANDIDATOS_ESTIMATIVA = OrienteeringProblemSolver::MAX_LOCAIS_DP_ESPARSA;
+
+    // Constantes de tempo (ms)
+    constexpr double MS_POR_AVALIACAO_GULOSO = 25e-6;     // Por (local, passo)
+    constexpr double FATOR_BUSCA_LOCAL = 5.0;             // Guloso + busca local / guloso
+    constexpr double MS_POR_TRANSICAO_DP = 1.8e-6;        // Por (máscara, último, próximo)
+    constexpr double MS_POR_ESTADO_BB = 3e-3;             // Por estado alcançável estimado
+
+    struct Opcao {
+        Algoritmo algoritmo;
+        int qualidade;  // Índice em QualidadeAlvo
+        double tempoEstimadoMs;
+    };
+
+    int nivel(QualidadeAlvo qualidade) { return static_cast<int>(qualidade); }
+
+    const char* nomeQualidade(QualidadeAlvo qualidade) {
+        switch (qualidade) {
+            case QualidadeAlvo::Rapida: return "rapida";
+            case QualidadeAlvo::Refinada: return "refinada";
+            case QualidadeAlvo::Otima:
+            default: return "otima";
+        }
+    }
+
+    // Σ_k C(m, k) · k · q^(k(k-1)/2), parando quando os termos somem
+    double estimarEstados(int m, double densidade) {
+        double estados = 0.0;
+        double combinacoes = 1.0;
+        for (int k = 1; k <= m; ++k) {
+            combinacoes = combinacoes * (m - k + 1) / k;
+            const double termo = combinacoes * k * std::pow(densidade, 0.5 * k * (k - 1));
+            estados += termo;
+            if (k > 1 && termo < 1.0) break;
+        }
+        return estados;
+    }
+
+    bool melhorResultado(const ResultadoSolucao& a, const ResultadoSolucao& b) {
+        if (a.solucaoValida != b.solucaoValida) return a.solucaoValida;
+        if (a.pontuacaoTotal != b.pontuacaoTotal) return a.pontuacaoTotal > b.pontuacaoTotal;
+        return a.custoKm < b.custoKm;
+    }
+}
+
+bool interpretarQualidade(std::string_view nome, QualidadeAlvo& qualidade) {
+    if (nome == "rapida") qualidade = QualidadeAlvo::Rapida;
+    else if (nome == "refinada") qualidade = QualidadeAlvo::Refinada;
+    else if (nome == "otima") qualidade = QualidadeAlvo::Otima;
+    else return false;
+    return true;
+}
+
+ResultadoSolucao OrienteeringProblemSolver::resolver(const ParametrosViagem& params, const SLAConsulta& sla,
+                                                     DecisaoDespacho* decisao) {
+    auto inicioTempo = std::chrono::steady_clock::now();
+
+    if (!params.validar()) {
+        erros() << "Parametros de viagem invalidos.\n";
+        return ResultadoSolucao();
+    }
+
+    validarDados();
+
+    const int n = static_cast<int>(locais.size());
+    const auto ponteiroDistOrigem = obterDistanciasOrigem(params);
+    const std::vector<double>& distOrigem = *ponteiroDistOrigem;
+
+    // No modo horário, os km alcançáveis no fator mais rápido do perfil
+    const bool dependenteDoTempo = modoHorario();
+    const RelogioViagem relogio(perfilVelocidade, locais, zonaLocal, params, distOrigem);
+    const double orcamentoKm = dependenteDoTempo ? relogio.kmAlcancaveis(relogio.partida())
+                                                 : params.orcamentoKm();
+
+    // CARACTERÍSTICAS DA CONSULTA
+
+    std::vector<int> candidatos;
+    for (int i = 0; i < n; ++i) {
+        if (2.0 * distOrigem[i] <= orcamentoKm + EPSILON) candidatos.push_back(i);
+    }
+    const int m = static_cast<int>(candidatos.size());
+
+    DecisaoDespacho escolha;
+    escolha.candidatos = m;
+
+    const bool estimavel = m <= MAX_CANDIDATOS_ESTIMATIVA;
+    if (estimavel && m > 1) {
+        long pares = 0;
+        for (int a = 0; a < m; ++a) {
+            for (int b = 0; b < m; ++b) {
+                if (a != b && distOrigem[candidatos[a]] + grafo.distancia(candidatos[a], candidatos[b]) +
+                              distOrigem[candidatos[b]] <= orcamentoKm + EPSILON) {
+                    ++pares;
+                }
+            }
+        }
+        escolha.densidadePares = static_cast<double>(pares) / (static_cast<double>(m) * (m - 1));
+    }
+    escolha.estadosEstimados = estimavel ? estimarEstados(m, escolha.densidadePares) : 0.0;
+
+    // SOLVERS POSSÍVEIS
+    //
+    // A DP esparsa fica de fora: nas medições ela nunca saiu mais barata
+    // que o branch-and-bound, que também dispensa a memória das camadas
+
+    std::vector<Opcao> opcoes;
+    const double tempoGuloso = MS_POR_AVALIACAO_GULOSO * n * (m + 1);
+    opcoes.push_back({Algoritmo::Guloso, nivel(QualidadeAlvo::Rapida), tempoGuloso});
+    opcoes.push_back({Algoritmo::GulosoBuscaLocal, nivel(QualidadeAlvo::Refinada),
+                      tempoGuloso * FATOR_BUSCA_LOCAL});
+
+    const bool dpCabe = n <= MAX_LOCAIS_DP &&
+        (sla.opcoesDP.memoriaMaximaBytes == 0 ||
+         memoriaNecessariaDP(n, sla.opcoesDP) <= sla.opcoesDP.memoriaMaximaBytes);
+    if (dpCabe) {
+        const int threads = resolverNumeroThreads(sla.opcoesDP.numThreads);
+        opcoes.push_back({Algoritmo::ProgramacaoDinamica, nivel(QualidadeAlvo::Otima),
+                          MS_POR_TRANSICAO_DP * std::ldexp(1.0, n) * n * n / threads});
+    }
+    // Branch-and-bound não segue visitas, janelas nem o perfil de velocidade
+    if (estimavel && !dependenteDoTempo) {
+        opcoes.push_back({Algoritmo::BranchAndBound, nivel(QualidadeAlvo::Otima),
+                          MS_POR_ESTADO_BB * escolha.estadosEstimados});
+    }
+
+    // ESCOLHA: o mais barato que atende qualidade e latência; senão, a
+    // maior qualidade que cabe na latência (o guloso sempre cabe)
+
+    auto cabe = [&](const Opcao& opcao) {
+        return sla.latenciaMaximaMs <= 0 || opcao.tempoEstimadoMs <= sla.latenciaMaximaMs ||
+               opcao.algoritmo == Algoritmo::Guloso;
+    };
+
+    const Opcao* escolhida = nullptr;
+    for (const Opcao& opcao : opcoes) {
+        if (opcao.qualidade < nivel(sla.qualidade) || !cabe(opcao)) continue;
+        if (!escolhida || opcao.tempoEstimadoMs < escolhida->tempoEstimadoMs) escolhida = &opcao;
+    }
+    if (!escolhida) {
+        escolha.metaAtendida = false;
+        for (const Opcao& opcao : opcoes) {
+            if (!cabe(opcao)) continue;
+            if (!escolhida || opcao.qualidade > escolhida->qualidade ||
+                (opcao.qualidade == escolhida->qualidade && opcao.tempoEstimadoMs < escolhida->tempoEstimadoMs)) {
+                escolhida = &opcao;
+            }
+        }
+    }
+
+    escolha.algoritmo = escolhida->algoritmo;
+    escolha.tempoEstimadoMs = escolhida->tempoEstimadoMs;
+
+    // EXECUÇÃO com a latência como prazo, sem perder o cancelamento de quem chamou
+
+    ParametrosViagem paramsDespacho = params;
+    std::optional<Interrupcao> prazo;
+    if (sla.latenciaMaximaMs > 0) {
+        prazo.emplace(inicioTempo + std::chrono::milliseconds(sla.latenciaMaximaMs), params.interrupcao);
+        paramsDespacho.interrupcao = &*prazo;
+    }
+
+    ResultadoSolucao resultado = resolver(escolha.algoritmo, paramsDespacho, sla.opcoesDP);
+
+    // Exato interrompido: a rota parcial pode perder para a busca local,
+    // que custa microssegundos
+    if (resultado.interrompida && escolhida->qualidade == nivel(QualidadeAlvo::Otima)) {
+        ResultadoSolucao heuristica = resolverGulosoComBuscaLocal(params);
+        if (melhorResultado(heuristica, resultado)) {
+            heuristica.interrompida = true;
+            resultado = std::move(heuristica);
+        }
+    }
+
+    const long tempoTotalMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - inicioTempo).count();
+    resultado.tempoExecucaoMs = tempoTotalMs;
+
+    // Uma linha por consulta, com características, estimativa e tempo real.
+    // Fora de saida(): lote e servidor rodam silenciosos e é deles que vêm
+    // as medições
+    std::ostringstream registro;
+    registro << std::setprecision(3) << "Despacho: n=" << n << " candidatos=" << m
+             << " densidade=" << escolha.densidadePares << " estados~" << escolha.estadosEstimados
+             << " qualidade=" << nomeQualidade(sla.qualidade) << " latencia=" << sla.latenciaMaximaMs
+             << "ms -> " << nomeAlgoritmo(escolha.algoritmo) << " estimado=" << escolha.tempoEstimadoMs
+             << "ms real=" << tempoTotalMs << "ms"
+             << (escolha.metaAtendida ? "" : " meta-nao-atendida")
+             << (resultado.interrompida ? " interrompido" : "") << "\n";
+    if (registroDespacho) {
+        registroDespacho(registro.str());
+    } else {
+        std::clog << registro.str();  // Uma escrita só, para não intercalar entre threads
+    }
+
+    if (decisao) *decisao = escolha;
+    return resultado;
+}
@@ -0,0 +1,160 @@
+#ifndef ESPACO_TRABALHO_H
+#define ESPACO_TRABALHO_H
+
+#include "TabelaDP.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// ESPAÇO DE TRABALHO DOS SOLVERS (UM POR THREAD)
+//
+// Os vetores de cada consulta (matriz de distâncias da DP, pontuação por
+// máscara, ordem das camadas, visitados e rota do guloso, ...) saem de uma
+// arena da thread em vez do heap. A arena é uma pilha: cada solver abre um
+// Escopo e tudo o que alocou dentro dele é devolvido na saída, o que permite
+// chamadas aninhadas (despacho -> DP, guloso -> busca local). Quando a pilha
+// esvazia, blocos extras criados por falta de espaço são fundidos num só,
+// então a partir da segunda consulta do mesmo tamanho nada vai ao heap nem
+// gera page faults. As tabelas da DP densa ficam à parte e também são
+// reaproveitadas: TabelaDP::preparar só realoca se n crescer.
+//
+// A arena não é devolvida ao sistema enquanto a thread viver (ela acompanha
+// o catálogo, não a DP). As tabelas só ficam se couberem em
+// OpcoesDP::retencaoTabelaBytes e no teto de memória da consulta; acima
+// disso a DP as libera ao terminar (ver limitarTabelas).
+
+class ArenaTrabalho {
+	    // Posição da pilha na abertura de um Escopo
+	    struct Marca {
+	        std::size_t bloco;
+	        std::size_t usado;
+	    };
+
+	public:
+	    // Devolve à arena, ao sair do escopo, tudo o que foi alocado dentro dele
+	    class Escopo {
+	    public:
+	        explicit Escopo(ArenaTrabalho& arenaEscopo) : arena(arenaEscopo), marca(arenaEscopo.abrirEscopo()) {}
+	        ~Escopo() { arena.fecharEscopo(marca); }
+
+	        Escopo(const Escopo&) = delete;
+	        Escopo& operator=(const Escopo&) = delete;
+
+	    private:
+	        ArenaTrabalho& arena;
+	        const Marca marca;
+	    };
+
+	    ArenaTrabalho() = default;
+	    ArenaTrabalho(const ArenaTrabalho&) = delete;
+	    ArenaTrabalho& operator=(const ArenaTrabalho&) = delete;
+
+	    // quantidade objetos construídos por default (tipos triviais ficam sem
+	    // inicializar); válidos até o fim do Escopo corrente
+	    template <typename T>
+	    T* alocar(std::size_t quantidade) {
+	        static_assert(std::is_trivially_destructible_v<T>, "A arena nao chama destrutores");
+	        T* inicio = static_cast<T*>(alocarBytes(quantidade * sizeof(T), alignof(T)));
+	        std::uninitialized_default_construct_n(inicio, quantidade);
+	        return inicio;
+	    }
+
+	    // Garante um bloco único de pelo menos 'bytes'; só fora de escopos
+	    void reservar(std::size_t bytes) {
+	        if (escoposAbertos == 0 && capacidade() < bytes) {
+	            blocos.clear();
+	            novoBloco(bytes);
+	        }
+	    }
+
+	    std::size_t capacidade() const {
+	        std::size_t total = 0;
+	        for (const Bloco& bloco : blocos) total += bloco.tamanho;
+	        return total;
+	    }
+
+	private:
+	    static constexpr std::size_t TAMANHO_MINIMO_BLOCO = std::size_t(64) * 1024;
+
+	    struct Bloco {
+	        std::unique_ptr<std::byte[]> dados;
+	        std::size_t tamanho;
+	        std::size_t usado;
+	    };
+
+	    std::vector<Bloco> blocos;
+	    std::size_t atual = 0;  // Bloco em uso; os seguintes estão livres
+	    int escoposAbertos = 0;
+
+	    void novoBloco(std::size_t tamanho) {
+	        blocos.push_back({std::unique_ptr<std::byte[]>(new std::byte[tamanho]), tamanho, 0});
+	        atual = blocos.size() - 1;
+	    }
+
+	    void* alocarBytes(std::size_t bytes, std::size_t alinhamento) {
+	        while (atual < blocos.size()) {
+	            Bloco& bloco = blocos[atual];
+	            const auto endereco = reinterpret_cast<std::uintptr_t>(bloco.dados.get()) + bloco.usado;
+	            const std::size_t inicio = bloco.usado + ((alinhamento - endereco % alinhamento) % alinhamento);
+	            if (inicio + bytes <= bloco.tamanho) {
+	                bloco.usado = inicio + bytes;
+	                return bloco.dados.get() + inicio;
+	            }
+	            if (atual + 1 == blocos.size()) break;
+	            blocos[++atual].usado = 0;
+	        }
+
+	        // Crescimento geométrico: poucas consolidações até o tamanho estável
+	        novoBloco(std::max({bytes + alinhamento, TAMANHO_MINIMO_BLOCO, capacidade()}));
+	        Bloco& bloco = blocos[atual];
+	        const auto endereco = reinterpret_cast<std::uintptr_t>(bloco.dados.get());
+	        const std::size_t inicio = (alinhamento - endereco % alinhamento) % alinhamento;
+	        bloco.usado = inicio + bytes;
+	        return bloco.dados.get() + inicio;
+	    }
+
+	    Marca abrirEscopo() {
+	        ++escoposAbertos;
+	        return {atual, atual < blocos.size() ? blocos[atual].usado : 0};
+	    }
+
+	    void fecharEscopo(const Marca& marca) {
+	        atual = marca.bloco;
+	        if (atual < blocos.size()) blocos[atual].usado = marca.usado;
+
+	        // Pilha vazia: funde os blocos para que a próxima consulta caiba em um só
+	        if (--escoposAbertos == 0 && blocos.size() > 1) {
+	            const std::size_t total = capacidade();
+	            blocos.clear();
+	            novoBloco(total);
+	        }
+	    }
+};
+
+struct EspacoTrabalho {
+    ArenaTrabalho arena;
+    TabelaDP<double> tabelaDupla;
+    TabelaDP<float> tabelaSimples;
+
+    std::size_t bytesTabelas() const {
+        return tabelaDupla.bytesReservados() + tabelaSimples.bytesReservados();
+    }
+
+    // Libera as tabelas se, juntas, passarem de 'bytes'
+    void limitarTabelas(std::size_t bytes) {
+        if (bytesTabelas() > bytes) {
+            tabelaDupla.liberar();
+            tabelaSimples.liberar();
+        }
+    }
+
+    static EspacoTrabalho& daThread() {
+        thread_local EspacoTrabalho espaco;
+        return espaco;
+    }
+};
+
+#endif // ESPACO_TRABALHO_H
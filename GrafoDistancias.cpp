@@ -0,0 +1,182 @@
+#include "GrafoDistancias.h"
+#include "IndiceEspacial.h"
+#include "Paralelismo.h"
+#include <atomic>
+#include <cmath>
+#include <utility>
+
+namespace {
+    // Linhas por bloco na distribuição dinâmica entre threads
+    constexpr int LINHAS_POR_BLOCO = 16;
+    
+    template <typename Tarefa>
+    void paraCadaLinhaEmParalelo(int n, int numThreads, Tarefa&& tarefa) {
+        std::atomic<int> proxima(0);
+        numThreads = std::min(resolverNumeroThreads(numThreads),
+                              std::max(1, (n + LINHAS_POR_BLOCO - 1) / LINHAS_POR_BLOCO));
+        
+        executarEmParalelo(numThreads, [&](int) {
+            while (true) {
+                const int inicio = proxima.fetch_add(LINHAS_POR_BLOCO, std::memory_order_relaxed);
+                if (inicio >= n) break;
+                
+                const int fim = std::min(n, inicio + LINHAS_POR_BLOCO);
+                for (int i = inicio; i < fim; ++i) {
+                    tarefa(i);
+                }
+            }
+        });
+    }
+}
+
+void GrafoDistancias::liberar() {
+    matriz = nullptr;
+    vizinhos = nullptr;
+    distanciasVizinhos = nullptr;
+    k = 0;
+    
+    matrizPropria = std::vector<double>();
+    vizinhosProprios = std::vector<int>();
+    distanciasVizinhosProprias = std::vector<double>();
+    donoExterno.reset();
+}
+
+GrafoDistancias& GrafoDistancias::operator=(GrafoDistancias&& outro) noexcept {
+    if (this == &outro) return *this;
+    
+    n = outro.n;
+    k = outro.k;
+    coordenadas = std::move(outro.coordenadas);
+    matriz = outro.matriz;
+    vizinhos = outro.vizinhos;
+    distanciasVizinhos = outro.distanciasVizinhos;
+    matrizPropria = std::move(outro.matrizPropria);
+    vizinhosProprios = std::move(outro.vizinhosProprios);
+    distanciasVizinhosProprias = std::move(outro.distanciasVizinhosProprias);
+    donoExterno = std::move(outro.donoExterno);
+    
+    outro.n = 0;
+    outro.coordenadas = CoordenadasEsfericas();
+    outro.liberar();
+    return *this;
+}
+
+GrafoDistancias::Visao GrafoDistancias::visao() const {
+    Visao v;
+    v.numLocais = n;
+    v.vizinhosPorLocal = matriz ? 0 : k;
+    v.x = coordenadas.x.data();
+    v.y = coordenadas.y.data();
+    v.z = coordenadas.z.data();
+    v.matriz = matriz;
+    v.vizinhos = vizinhos;
+    v.distanciasVizinhos = distanciasVizinhos;
+    return v;
+}
+
+void GrafoDistancias::adotar(const Visao& externa, std::shared_ptr<const void> dono) {
+    liberar();
+    
+    n = externa.numLocais;
+    k = externa.vizinhosPorLocal;
+    coordenadas.x.assign(externa.x, externa.x + n);
+    coordenadas.y.assign(externa.y, externa.y + n);
+    coordenadas.z.assign(externa.z, externa.z + n);
+    
+    matriz = externa.matriz;
+    vizinhos = externa.vizinhos;
+    distanciasVizinhos = externa.distanciasVizinhos;
+    donoExterno = std::move(dono);
+}
+
+void GrafoDistancias::construirDenso(const std::vector<double>& latitudesGraus,
+                                     const std::vector<double>& longitudesGraus, int numThreads) {
+    liberar();
+    coordenadas.definir(latitudesGraus, longitudesGraus);
+    n = coordenadas.tamanho();
+    
+    // Linhas inteiras (e não só o triângulo superior): escrita contígua, e o
+    // cálculo já é simétrico bit a bit
+    matrizPropria.resize(static_cast<std::size_t>(n) * n);
+    paraCadaLinhaEmParalelo(n, numThreads, [&](int i) {
+        distanciasEmLoteKm(coordenadas.ponto(i), coordenadas, 0, n,
+                           matrizPropria.data() + static_cast<std::size_t>(i) * n);
+    });
+    matriz = matrizPropria.data();
+}
+
+void GrafoDistancias::construirEsparso(const std::vector<double>& latitudesGraus,
+                                       const std::vector<double>& longitudesGraus,
+                                       const IndiceEspacial& indice, int vizinhosPorLocal, int numThreads) {
+    liberar();
+    coordenadas.definir(latitudesGraus, longitudesGraus);
+    n = coordenadas.tamanho();
+    
+    // Todo local recebe exatamente k vizinhos, então as linhas têm tamanho fixo
+    k = std::max(0, std::min(vizinhosPorLocal, n - 1));
+    vizinhosProprios.assign(static_cast<std::size_t>(n) * k, 0);
+    distanciasVizinhosProprias.assign(static_cast<std::size_t>(n) * k, 0.0);
+    
+    // Raio inicial: área média de k locais na caixa envolvente
+    double latitudeMinima = 0.0, latitudeMaxima = 0.0, longitudeMinima = 0.0, longitudeMaxima = 0.0;
+    if (n > 0) {
+        latitudeMinima = *std::min_element(latitudesGraus.begin(), latitudesGraus.end());
+        latitudeMaxima = *std::max_element(latitudesGraus.begin(), latitudesGraus.end());
+        longitudeMinima = *std::min_element(longitudesGraus.begin(), longitudesGraus.end());
+        longitudeMaxima = *std::max_element(longitudesGraus.begin(), longitudesGraus.end());
+    }
+    const double diagonal = distanciaHaversineKm(latitudeMinima, longitudeMinima, latitudeMaxima, longitudeMaxima);
+    const double raioInicial = std::max(1e-3, diagonal * std::sqrt((k + 1.0) / std::max(1, n)));
+    
+    // Meia circunferência: nenhum par passa disso. A diagonal da caixa não
+    // serve de teto, porque não limita pares através do antimeridiano
+    const double raioMaximo = M_PI * RAIO_TERRA_KM;
+    
+    paraCadaLinhaEmParalelo(n, numThreads, [&](int i) {
+        thread_local std::vector<std::pair<double, int>> proximos;
+        thread_local std::vector<std::pair<int, double>> linha;
+        
+        // Dobra o raio até achar k vizinhos dentro dele; só então os k mais
+        // próximos encontrados são garantidamente os k mais próximos
+        double raio = raioInicial;
+        while (true) {
+            proximos.clear();
+            indice.paraCadaProximo(latitudesGraus[i], longitudesGraus[i], raio, [&](int j) {
+                if (j == i) return;
+                const double dist = calcular(i, j);
+                if (dist <= raio) proximos.emplace_back(dist, j);
+            });
+            
+            if (static_cast<int>(proximos.size()) >= k) break;
+            
+            // No teto o índice já devolveu tudo; o que faltar é arredondamento
+            // na borda do raio, então a linha é completada varrendo todos
+            if (raio >= raioMaximo) {
+                proximos.clear();
+                for (int j = 0; j < n; ++j) {
+                    if (j != i) proximos.emplace_back(calcular(i, j), j);
+                }
+                break;
+            }
+            raio = std::min(2.0 * raio, raioMaximo);
+        }
+        
+        // k <= n - 1, então a varredura completa sempre fecha a linha
+        const int encontrados = std::min(k, static_cast<int>(proximos.size()));
+        std::partial_sort(proximos.begin(), proximos.begin() + encontrados, proximos.end());
+        
+        linha.clear();
+        for (int v = 0; v < encontrados; ++v) {
+            linha.emplace_back(proximos[v].second, proximos[v].first);
+        }
+        std::sort(linha.begin(), linha.end());
+        
+        for (int v = 0; v < encontrados; ++v) {
+            vizinhosProprios[static_cast<std::size_t>(i) * k + v] = linha[v].first;
+            distanciasVizinhosProprias[static_cast<std::size_t>(i) * k + v] = linha[v].second;
+        }
+    });
+    
+    vizinhos = vizinhosProprios.data();
+    distanciasVizinhos = distanciasVizinhosProprias.data();
+}
@@ -0,0 +1,119 @@
+#ifndef GRAFO_DISTANCIAS_H
+#define GRAFO_DISTANCIAS_H
+
+#include "Haversine.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class IndiceEspacial;
+
+// PROVEDOR DE DISTÂNCIAS ENTRE LOCAIS
+//
+// Interface comum dos solvers para d(i, j), com duas representações:
+//   denso   matriz n x n linearizada, O(n²) memória
+//   esparso só os k vizinhos mais próximos de cada local, em arrays CSR
+//           (ordenados por índice, para busca binária); os demais pares
+//           são calculados sob demanda por Haversine
+// Nos dois modos o valor vem do mesmo cálculo em lote (distanciaCordaKm,
+// idêntico bit a bit ao kernel vetorizado), então os solvers produzem
+// exatamente as mesmas rotas.
+//
+// Matriz e arrays CSR são lidos por ponteiro: podem ser vetores próprios
+// (construídos aqui) ou regiões de um snapshot mapeado em memória, mantido
+// vivo enquanto o grafo o referenciar.
+
+class GrafoDistancias {
+	public:
+	    GrafoDistancias() = default;
+	    GrafoDistancias(const GrafoDistancias&) = delete;             // Ponteiros para os próprios vetores
+	    GrafoDistancias& operator=(const GrafoDistancias&) = delete;
+	    
+	    // Mover é seguro: os vetores passam o buffer adiante sem copiar, então
+	    // os ponteiros continuam válidos; o grafo de origem fica vazio
+	    GrafoDistancias(GrafoDistancias&& outro) noexcept { *this = std::move(outro); }
+	    GrafoDistancias& operator=(GrafoDistancias&& outro) noexcept;
+	    
+	    // Linhas calculadas em paralelo (numThreads = 0 usa todos os núcleos)
+	    void construirDenso(const std::vector<double>& latitudesGraus, const std::vector<double>& longitudesGraus,
+	                        int numThreads = 0);
+	    void construirEsparso(const std::vector<double>& latitudesGraus, const std::vector<double>& longitudesGraus,
+	                          const IndiceEspacial& indice, int vizinhosPorLocal, int numThreads = 0);
+	    
+	    // Arrays brutos do grafo, para gravação e carga de snapshots
+	    struct Visao {
+	        int numLocais = 0;
+	        int vizinhosPorLocal = 0;         // 0 no modo denso
+	        const double* x = nullptr;        // Vetores unitários (SoA)
+	        const double* y = nullptr;
+	        const double* z = nullptr;
+	        const double* matriz = nullptr;   // n x n, modo denso
+	        const int* vizinhos = nullptr;    // n x k, modo esparso
+	        const double* distanciasVizinhos = nullptr;
+	    };
+	    
+	    Visao visao() const;
+	    
+	    // Passa a ler os arrays de outra memória (ex.: mmap); 'dono' mantém
+	    // essa memória válida. As coordenadas são copiadas (O(n)).
+	    void adotar(const Visao& externa, std::shared_ptr<const void> dono);
+	    
+	    int quantidadeLocais() const { return n; }
+	    bool denso() const { return matriz != nullptr || n == 0; }
+	    
+	    double distancia(int i, int j) const {
+	        if (matriz) {
+	            return matriz[static_cast<std::size_t>(i) * n + j];
+	        }
+	        if (i == j) return 0.0;
+	        
+	        double valor;
+	        if (buscarVizinho(i, j, valor) || buscarVizinho(j, i, valor)) {
+	            return valor;
+	        }
+	        return calcular(i, j);
+	    }
+	    
+	    // Distâncias de um ponto qualquer (ex.: a origem) a todos os locais
+	    void distanciasDoPonto(double latitude, double longitude, double* saida) const {
+	        distanciasEmLoteKm(PontoEsferico::deGraus(latitude, longitude), coordenadas, 0, n, saida);
+	    }
+	    
+	    // Pares guardados em memória (n² no modo denso)
+	    std::size_t paresArmazenados() const {
+	        return matriz ? static_cast<std::size_t>(n) * n : static_cast<std::size_t>(n) * k;
+	    }
+
+	private:
+	    int n = 0;
+	    int k = 0;                                 // Vizinhos por local (modo esparso)
+	    CoordenadasEsfericas coordenadas;
+	    
+	    const double* matriz = nullptr;            // Modo denso: n x n
+	    const int* vizinhos = nullptr;             // Modo esparso: linha i em [i·k, (i+1)·k)
+	    const double* distanciasVizinhos = nullptr;
+	    
+	    std::vector<double> matrizPropria;
+	    std::vector<int> vizinhosProprios;
+	    std::vector<double> distanciasVizinhosProprias;
+	    std::shared_ptr<const void> donoExterno;   // Snapshot mapeado, se houver
+	    
+	    void liberar();
+	    
+	    double calcular(int i, int j) const {
+	        return distanciaCordaKm(coordenadas.ponto(i), coordenadas.ponto(j));
+	    }
+	    
+	    bool buscarVizinho(int i, int j, double& valor) const {
+	        const int* primeiro = vizinhos + static_cast<std::size_t>(i) * k;
+	        const int* ultimo = primeiro + k;
+	        const int* it = std::lower_bound(primeiro, ultimo, j);
+	        if (it == ultimo || *it != j) return false;
+	        valor = distanciasVizinhos[it - vizinhos];
+	        return true;
+	    }
+};
+
+#endif // GRAFO_DISTANCIAS_H
@@ -0,0 +1,279 @@
+#include "Solver.h"
+#include "BuscaLocal.h"
+#include "Paralelismo.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+
+// GRASP + BUSCA LOCAL ITERADA (PARALELO)
+//
+// Cada iteração constrói uma rota com o critério do guloso, mas sorteando o
+// próximo local entre os de razão próxima da melhor (lista restrita de
+// candidatos), aplica a busca local e então alterna perturbações (remoção de
+// um trecho aleatório) com nova busca local. As iterações são distribuídas
+// entre as threads por um contador atômico; cada thread tem seu próprio
+// gerador e a melhor rota é compartilhada sob mutex.
+
+namespace {
+    constexpr double EPSILON = 1e-9;
+    
+    struct SolucaoGRASP {
+        int pontuacao = 0;
+        double custo = 0.0;
+        std::vector<int> rota;
+        
+        // Maior pontuação e, depois, menor custo
+        bool melhorQue(int outraPontuacao, double outroCusto) const {
+            return pontuacao > outraPontuacao ||
+                   (pontuacao == outraPontuacao && custo < outroCusto - EPSILON);
+        }
+    };
+    
+    class ConstrutorAleatorizado {
+    public:
+        ConstrutorAleatorizado(const GrafoDistancias& distancias,
+                               const std::vector<double>& distOrigem,
+                               const std::vector<int>& pontuacoes,
+                               double orcamentoKm, double alfaRcl)
+            : dist(distancias), distS(distOrigem), pontos(pontuacoes),
+              orcamento(orcamentoKm), alfa(alfaRcl), visitado(pontuacoes.size(), 0)
+        {
+            for (int i = 0; i < static_cast<int>(pontuacoes.size()); ++i) {
+                if (2.0 * distS[i] <= orcamento + EPSILON) candidatos.push_back(i);
+            }
+        }
+        
+        std::vector<int> construir(std::mt19937& gerador) {
+            std::fill(visitado.begin(), visitado.end(), 0);
+            std::vector<int> rota;
+            
+            double custo = 0.0;
+            int atual = -1;
+            
+            while (true) {
+                viaveis.clear();
+                razoes.clear();
+                double maiorRazao = -1.0;
+                double menorRazao = 0.0;
+                
+                for (int i : candidatos) {
+                    if (visitado[i]) continue;
+                    
+                    const double distAteI = (atual == -1) ? distS[i] : dist.distancia(atual, i);
+                    if (custo + distAteI + distS[i] > orcamento + EPSILON) continue;
+                    
+                    const double razao = pontos[i] / (distAteI + EPSILON);
+                    if (viaveis.empty() || razao > maiorRazao) maiorRazao = razao;
+                    if (viaveis.empty() || razao < menorRazao) menorRazao = razao;
+                    viaveis.push_back(i);
+                    razoes.push_back(razao);
+                }
+                
+                if (viaveis.empty()) break;
+                
+                // Lista restrita: razão >= melhor - alfa · (melhor - pior)
+                const double corte = maiorRazao - alfa * (maiorRazao - menorRazao);
+                std::size_t tamanho = 0;
+                for (std::size_t c = 0; c < viaveis.size(); ++c) {
+                    if (razoes[c] >= corte) viaveis[tamanho++] = viaveis[c];
+                }
+                
+                std::uniform_int_distribution<std::size_t> sorteio(0, tamanho - 1);
+                const int proximo = viaveis[sorteio(gerador)];
+                
+                custo += (atual == -1) ? distS[proximo] : dist.distancia(atual, proximo);
+                visitado[proximo] = 1;
+                rota.push_back(proximo);
+                atual = proximo;
+            }
+            
+            return rota;
+        }
+        
+    private:
+        const GrafoDistancias& dist;
+        const std::vector<double>& distS;
+        const std::vector<int>& pontos;
+        const double orcamento;
+        const double alfa;
+        
+        std::vector<int> candidatos;
+        std::vector<char> visitado;
+        std::vector<int> viaveis;
+        std::vector<double> razoes;
+    };
+    
+    // Remove um trecho aleatório de até 1/4 da rota (no mínimo um local)
+    void perturbar(std::vector<int>& rota, std::mt19937& gerador) {
+        if (rota.empty()) return;
+        
+        const std::size_t maximo = std::max<std::size_t>(1, rota.size() / 4);
+        std::uniform_int_distribution<std::size_t> sorteioTamanho(1, maximo);
+        const std::size_t tamanho = sorteioTamanho(gerador);
+        
+        std::uniform_int_distribution<std::size_t> sorteioInicio(0, rota.size() - tamanho);
+        const std::size_t inicio = sorteioInicio(gerador);
+        
+        rota.erase(rota.begin() + inicio, rota.begin() + inicio + tamanho);
+    }
+}
+
+ResultadoSolucao OrienteeringProblemSolver::resolverGRASP(const ParametrosViagem& params,
+                                                          const OpcoesGRASP& opcoes) {
+    auto inicioTempo = std::chrono::high_resolution_clock::now();
+    CronometroFases cronometro;
+    
+    saida() << "\nIniciando GRASP + Busca Local Iterada (Heuristica)...\n";
+    
+    ResultadoSolucao resultado;
+    
+    // Validações
+    if (!params.validar()) {
+        erros() << "Parametros de viagem invalidos.\n";
+        return resultado;
+    }
+    
+    if (recusaModoHorario("GRASP")) {
+        return resultado;
+    }
+    
+    validarDados();
+    
+    const int n = static_cast<int>(locais.size());
+    const double orcamentoKm = params.orcamentoKm();
+    
+    const auto ponteiroDistOrigem = obterDistanciasOrigem(params);
+    const std::vector<double>& distOrigem = *ponteiroDistOrigem;
+    
+    std::vector<int> pontuacoes(n);
+    for (int i = 0; i < n; ++i) {
+        pontuacoes[i] = locais[i].pontuacao;
+    }
+    
+    // tempoLimiteMs é o orçamento do próprio GRASP; a Interrupcao da
+    // consulta também para as iterações e marca o resultado
+    const auto prazo = std::chrono::steady_clock::now() + std::chrono::milliseconds(opcoes.tempoLimiteMs);
+    std::atomic<bool> paradaExterna(false);
+    auto prazoEsgotado = [&]() {
+        if (interrompida(params.interrupcao)) {
+            paradaExterna.store(true, std::memory_order_relaxed);
+            return true;
+        }
+        return opcoes.tempoLimiteMs > 0 && std::chrono::steady_clock::now() >= prazo;
+    };
+    
+    // Incumbente inicial: a construção gulosa pura (alfa 0), feita fora do
+    // prazo, para que um GRASP parado antes da primeira iteração ainda
+    // devolva uma rota viável
+    SolucaoGRASP melhorGlobal;
+    {
+        ConstrutorAleatorizado guloso(grafo, distOrigem, pontuacoes, orcamentoKm, 0.0);
+        std::mt19937 gerador(opcoes.semente);
+        melhorGlobal.rota = guloso.construir(gerador);
+        
+        int anterior = -1;
+        for (int local : melhorGlobal.rota) {
+            melhorGlobal.pontuacao += pontuacoes[local];
+            melhorGlobal.custo += (anterior == -1) ? distOrigem[local] : grafo.distancia(anterior, local);
+            anterior = local;
+        }
+        if (anterior != -1) melhorGlobal.custo += distOrigem[anterior];
+    }
+    std::mutex mutexMelhor;
+    std::atomic<int> proximaIteracao(0);
+    std::atomic<long> iteracoesConcluidas(0);
+    
+    const int numThreads = std::min(resolverNumeroThreads(opcoes.numThreads),
+                                    std::max(1, opcoes.maxIteracoes));
+    resultado.metricas.preparacaoNs = cronometro.marcar();
+    
+    executarEmParalelo(numThreads, [&](int idThread) {
+        std::seed_seq sementes{opcoes.semente, static_cast<unsigned int>(idThread)};
+        std::mt19937 gerador(sementes);
+        
+        ConstrutorAleatorizado construtor(grafo, distOrigem, pontuacoes, orcamentoKm, opcoes.alfa);
+        BuscaLocal busca(grafo, distOrigem, pontuacoes, orcamentoKm);
+        
+        // Incumbente da thread: só toca o mutex quando melhora
+        SolucaoGRASP melhorLocal;
+        
+        while (proximaIteracao.fetch_add(1, std::memory_order_relaxed) < opcoes.maxIteracoes &&
+               !prazoEsgotado())
+        {
+            SolucaoGRASP atual;
+            atual.rota = construtor.construir(gerador);
+            busca.melhorar(atual.rota);
+            atual.pontuacao = busca.pontuacao();
+            atual.custo = busca.custo();
+            
+            for (int p = 0; p < opcoes.perturbacoesILS && !prazoEsgotado(); ++p) {
+                std::vector<int> vizinha = atual.rota;
+                perturbar(vizinha, gerador);
+                busca.melhorar(vizinha);
+                
+                // Aceita empates para caminhar em platôs
+                if (busca.pontuacao() > atual.pontuacao ||
+                    (busca.pontuacao() == atual.pontuacao && busca.custo() <= atual.custo))
+                {
+                    atual.rota = std::move(vizinha);
+                    atual.pontuacao = busca.pontuacao();
+                    atual.custo = busca.custo();
+                }
+            }
+            
+            iteracoesConcluidas.fetch_add(1, std::memory_order_relaxed);
+            
+            if (!atual.rota.empty() &&
+                (melhorLocal.rota.empty() || atual.melhorQue(melhorLocal.pontuacao, melhorLocal.custo)))
+            {
+                melhorLocal = atual;
+                
+                std::lock_guard<std::mutex> trava(mutexMelhor);
+                if (melhorGlobal.rota.empty() ||
+                    melhorLocal.melhorQue(melhorGlobal.pontuacao, melhorGlobal.custo))
+                {
+                    melhorGlobal = melhorLocal;
+                }
+            }
+        }
+    });
+    resultado.metricas.transicoesNs = cronometro.marcar();
+    resultado.metricas.estadosExpandidos = static_cast<uint64_t>(iteracoesConcluidas.load());
+    
+    if (!melhorGlobal.rota.empty()) {
+        // Custo recalculado do zero: os deltas da busca local acumulam arredondamento
+        const std::vector<int>& rota = melhorGlobal.rota;
+        double custoRota = distOrigem[rota.front()];
+        for (std::size_t i = 1; i < rota.size(); ++i) {
+            custoRota += grafo.distancia(rota[i - 1], rota[i]);
+        }
+        custoRota += distOrigem[rota.back()];
+        
+        if (custoRota <= orcamentoKm + EPSILON) {
+            resultado.rota = rota;
+            resultado.pontuacaoTotal = melhorGlobal.pontuacao;
+            resultado.custoKm = custoRota;
+            resultado.tempoHoras = custoRota / params.velocidadeKmh;
+            resultado.solucaoValida = true;
+        } else {
+            erros() << "AVISO: Rota construida excede orcamento!\n";
+        }
+    } else {
+        saida() << "Nenhuma rota valida encontrada dentro do orçamento de " 
+                << params.orcamentoHoras << " horas (" << orcamentoKm << " km).\n";
+    }
+    resultado.metricas.reconstrucaoNs = cronometro.marcar();
+    
+    saida() << "Iteracoes: " << iteracoesConcluidas.load() << " em " << numThreads << " threads\n";
+    resultado.interrompida = paradaExterna.load();
+    
+    // Tempo de execução
+    auto fimTempo = std::chrono::high_resolution_clock::now();
+    resultado.tempoExecucaoMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        fimTempo - inicioTempo).count();
+    
+    return resultado;
+}
@@ -1,4 +1,6 @@
 #include "Solver.h"
+#include "RelogioViagem.h"
+#include "EspacoTrabalho.h"
 #include <algorithm>
 #include <chrono>
 #include <iostream>
@@ -9,10 +11,14 @@
 namespace {
     constexpr double EPSILON = 1e-9;
     
+    // Abaixo disso a varredura linear é mais barata que consultar a grade
+    constexpr int MIN_LOCAIS_INDICE_ESPACIAL = 128;
+    
     struct CandidatoGuloso {
         int indice;
         double razaoBeneficio;
         double distanciaKm;
+        double custoChegada;  // Km acumulados, ou horário de saída no modo horário
         
         bool operator>(const CandidatoGuloso& outro) const {
             return razaoBeneficio > outro.razaoBeneficio;
@@ -24,14 +30,15 @@ ResultadoSolucao OrienteeringProblemSolver::resolverGuloso(
     const ParametrosViagem& params) 
 {
     auto inicioTempo = std::chrono::high_resolution_clock::now();
+    CronometroFases cronometro;
     
-    std::cout << "\nIniciando Algoritmo Guloso (Heuristica Rapida)...\n";
+    saida() << "\nIniciando Algoritmo Guloso (Heuristica Rapida)...\n";
     
     ResultadoSolucao resultado;
     
     // Validações
     if (!params.validar()) {
-        std::cerr << "Parametros de viagem invalidos.\n";
+        erros() << "Parametros de viagem invalidos.\n";
         return resultado;
     }
     
@@ -40,68 +47,147 @@ ResultadoSolucao OrienteeringProblemSolver::resolverGuloso(
     const int n = static_cast<int>(locais.size());
     const double orcamentoKm = params.orcamentoKm();
     
+    // Visitados e rota saem da arena da thread; só a rota devolvida vai ao heap
+    ArenaTrabalho& arena = EspacoTrabalho::daThread().arena;
+    ArenaTrabalho::Escopo escopo(arena);
+    
+    // Distâncias S -> i calculadas uma única vez (ou reaproveitadas do cache)
+    const auto ponteiroDistOrigem = obterDistanciasOrigem(params);
+    const std::vector<double>& distOrigem = *ponteiroDistOrigem;
+    
+    // No modo horário o custo acumulado é o horário de saída do local atual
+    // e o orçamento, o horário limite de volta a S; fora dele, ambos em km
+    const bool dependenteDoTempo = modoHorario();
+    const RelogioViagem relogio(perfilVelocidade, locais, zonaLocal, params, distOrigem);
+    const double orcamento = dependenteDoTempo ? relogio.limite() : orcamentoKm;
+    
+    // Custo depois de percorrer distanciaKm saindo de u (-1 = origem S)
+    auto avancar = [&](double custo, double distanciaKm, int u) {
+        if (!dependenteDoTempo) return custo + distanciaKm;
+        return relogio.viajar(custo, distanciaKm, u);
+    };
+    // Custo ao deixar i chegando com 'custo' (INFINITO se a janela não couber)
+    auto visitar = [&](int i, double custo) {
+        if (!dependenteDoTempo) return custo;
+        return relogio.visitar(i, custo);
+    };
+    const double custoInicial = dependenteDoTempo ? relogio.partida() : 0.0;
+    
     // Verificar viabilidade: é possível visitar pelo menos 1 local?
     bool existeSolucaoViavel = false;
     for (int i = 0; i < n; ++i) {
-        double custoIdaVolta = 2.0 * calcularDistanciaParaOrigem(i, params);
-        if (custoIdaVolta <= orcamentoKm + EPSILON) {
+        const double custoIdaVolta = avancar(visitar(i, avancar(custoInicial, distOrigem[i], -1)), distOrigem[i], i);
+        if (custoIdaVolta <= orcamento + EPSILON) {
             existeSolucaoViavel = true;
             break;
         }
     }
     
     if (!existeSolucaoViavel) {
-        std::cout << "Orcamento insuficiente para visitar qualquer local (ida + volta).\n";
+        saida() << "Orcamento insuficiente para visitar qualquer local (ida + volta).\n";
         auto fimTempo = std::chrono::high_resolution_clock::now();
         resultado.tempoExecucaoMs = std::chrono::duration_cast<std::chrono::milliseconds>(
             fimTempo - inicioTempo).count();
         return resultado;
     }
     
-    std::vector<bool> visitado(n, false);
-    std::vector<int> rota;
-    rota.reserve(n);
+    bool* visitado = arena.alocar<bool>(n);
+    std::fill_n(visitado, n, false);
+    int* rota = arena.alocar<int>(n);
+    int tamanhoRota = 0;
     
     int pontuacaoTotal = 0;
-    double custoAcumuladoKm = 0.0;
+    double custoAcumulado = custoInicial;
+    double distanciaAcumuladaKm = 0.0;
     int localAtual = -1;  // -1 representa a origem S
     
     // LOOP GULOSO: Escolher próximo local com melhor razão 
     // pontuação/distância
     
+    const bool usarIndice = n >= MIN_LOCAIS_INDICE_ESPACIAL && !indiceEspacial.vazio();
+    
+    // Sem perfil, a janela que já não cabe não cabe mais: o relógio só avança
+    // e, pela desigualdade triangular, passar por outro local nunca chega
+    // antes. Com perfil (ou zonas) um desvio por uma faixa mais rápida pode
+    // chegar antes, então o local só fica de fora da rodada atual
+    const bool janelaPerdidaDeVez = perfilVelocidade.vazio();
+    
+    Contador avaliados;
+    Contador rejeitados;  // Candidatos que não voltariam a S no orçamento
+    resultado.metricas.preparacaoNs = cronometro.marcar();
+    
     while (true) {
-        CandidatoGuloso melhorCandidato{-1, -1.0, 0.0};
+        // Interrompido: a rota parcial já volta a S dentro do orçamento
+        if (interrompida(params.interrupcao)) {
+            resultado.interrompida = true;
+            break;
+        }
         
-        // Avaliar todos os locais não visitados
-        for (int i = 0; i < n; ++i) {
-            if (visitado[i]) continue;
+        CandidatoGuloso melhorCandidato{-1, -1.0, 0.0, 0.0};
+        
+        auto avaliarCandidato = [&](int i) {
+            if (visitado[i]) return;
+            avaliados.somar();
             
             // Distância do local atual até i
             double distAtei;
             if (localAtual == -1) {
-                distAtei = calcularDistanciaParaOrigem(i, params);
+                distAtei = distOrigem[i];
             } else {
-                distAtei = distanciasKm[localAtual][i];
+                distAtei = grafo.distancia(localAtual, i);
             }
             
             // Distância de i de volta para origem
-            const double distVolta = calcularDistanciaParaOrigem(i, params);
+            const double distVolta = distOrigem[i];
             
             // CRÍTICO: Verifica se consegue ir até i E voltar para S
-            const double custoTotalSeEscolherI = custoAcumuladoKm + distAtei + distVolta;
+            const double custoAtei = visitar(i, avancar(custoAcumulado, distAtei, localAtual));
+            if (custoAtei == RelogioViagem::INFINITO) {
+                if (janelaPerdidaDeVez) visitado[i] = true;
+                rejeitados.somar();
+                return;
+            }
+            const double custoTotalSeEscolherI = avancar(custoAtei, distVolta, i);
             
-            if (custoTotalSeEscolherI > orcamentoKm + EPSILON) {
-                continue;  // Não cabe no orçamento
+            if (custoTotalSeEscolherI > orcamento + EPSILON) {
+                rejeitados.somar();
+                return;  // Não cabe no orçamento
             }
             
-            // Critério guloso: pontuação / distância até chegar em i
+            // Critério guloso: pontuação / distância (ou, no modo horário,
+            // tempo gasto até deixar i, com espera e visita)
+            const double esforco = dependenteDoTempo ? custoAtei - custoAcumulado : distAtei;
             const double razao = static_cast<double>(locais[i].pontuacao) / 
-                                (distAtei + EPSILON);
+                                (esforco + EPSILON);
             
-            if (razao > melhorCandidato.razaoBeneficio) {
+            // Empates ficam com o menor índice, como na varredura linear
+            if (razao > melhorCandidato.razaoBeneficio ||
+                (razao == melhorCandidato.razaoBeneficio && i < melhorCandidato.indice)) {
                 melhorCandidato.indice = i;
                 melhorCandidato.razaoBeneficio = razao;
                 melhorCandidato.distanciaKm = distAtei;
+                melhorCandidato.custoChegada = custoAtei;
+            }
+        };
+        
+        if (usarIndice) {
+            // Candidatos viáveis estão na elipse d(atual, i) + d(i, S) <= folga;
+            // pela desigualdade triangular, ela cabe no círculo em torno do
+            // local atual de raio (folga + d(atual, S)) / 2. No modo horário,
+            // a folga em km é a do fator mais rápido do perfil.
+            const double folga = dependenteDoTempo
+                ? relogio.kmAlcancaveis(custoAcumulado) + EPSILON
+                : orcamentoKm - custoAcumulado + EPSILON;
+            const double distAtualOrigem = (localAtual == -1) ? 0.0 : distOrigem[localAtual];
+            const double latitude = (localAtual == -1) ? params.latitudePartida : locais[localAtual].latitude;
+            const double longitude = (localAtual == -1) ? params.longitudePartida : locais[localAtual].longitude;
+            
+            indiceEspacial.paraCadaProximo(latitude, longitude, 0.5 * (folga + distAtualOrigem) + EPSILON,
+                                           avaliarCandidato);
+        } else {
+            // Avaliar todos os locais não visitados
+            for (int i = 0; i < n; ++i) {
+                avaliarCandidato(i);
             }
         }
         
@@ -113,35 +199,43 @@ ResultadoSolucao OrienteeringProblemSolver::resolverGuloso(
         // Adicionar melhor candidato à rota
         const int proximo = melhorCandidato.indice;
         visitado[proximo] = true;
-        rota.push_back(proximo);
-        custoAcumuladoKm += melhorCandidato.distanciaKm;
+        rota[tamanhoRota++] = proximo;
+        custoAcumulado = melhorCandidato.custoChegada;
+        distanciaAcumuladaKm += melhorCandidato.distanciaKm;
         pontuacaoTotal += locais[proximo].pontuacao;
         localAtual = proximo;
     }
+    resultado.metricas.transicoesNs = cronometro.marcar();
+    resultado.metricas.estadosExpandidos = static_cast<uint64_t>(tamanhoRota);
+    resultado.metricas.candidatosAvaliados = avaliados.total();
+    resultado.metricas.transicoesPodadas = rejeitados.total();
     
     // ADICIONAR VOLTA PARA ORIGEM E VALIDAÇÃO FINAL
     
-    if (!rota.empty()) {
-        const int ultimoLocal = rota.back();
-        const double distVolta = calcularDistanciaParaOrigem(ultimoLocal, params);
-        const double custoTotalFinal = custoAcumuladoKm + distVolta;
+    if (tamanhoRota > 0) {
+        const int ultimoLocal = rota[tamanhoRota - 1];
+        const double distVolta = distOrigem[ultimoLocal];
+        const double custoTotalFinal = avancar(custoAcumulado, distVolta, ultimoLocal);
+        const double distanciaTotalKm = distanciaAcumuladaKm + distVolta;
         
         // VALIDAÇÃO CRÍTICA: Verificar se a rota completa respeita orçamento
-        if (custoTotalFinal <= orcamentoKm + EPSILON) {
-            resultado.rota = rota;
+        if (custoTotalFinal <= orcamento + EPSILON) {
+            resultado.rota.assign(rota, rota + tamanhoRota);
             resultado.pontuacaoTotal = pontuacaoTotal;
-            resultado.custoKm = custoTotalFinal;
-            resultado.tempoHoras = custoTotalFinal / params.velocidadeKmh;
+            resultado.custoKm = distanciaTotalKm;
+            resultado.tempoHoras = dependenteDoTempo ? custoTotalFinal - params.horaPartida
+                                                     : distanciaTotalKm / params.velocidadeKmh;
             resultado.solucaoValida = true;
         } else {
             // Isso não deveria acontecer devido às verificações anteriores
-            std::cerr << "AVISO: Rota construida excede orcamento!\n";
-            std::cerr << "    Custo: " << custoTotalFinal << " km, Limite: " << orcamentoKm << " km\n";
+            erros() << "AVISO: Rota construida excede orcamento!\n";
+            erros() << "    Custo: " << custoTotalFinal << ", Limite: " << orcamento << "\n";
         }
     } else {
-        std::cout << "Nenhuma rota valida encontrada dentro do orçamento de " 
-                  << params.orcamentoHoras << " horas (" << orcamentoKm << " km).\n";
+        saida() << "Nenhuma rota valida encontrada dentro do orçamento de " 
+                << params.orcamentoHoras << " horas (" << orcamentoKm << " km).\n";
     }
+    resultado.metricas.reconstrucaoNs = cronometro.marcar();
     
     // Tempo de execução
     auto fimTempo = std::chrono::high_resolution_clock::now();
@@ -0,0 +1,142 @@
+#include "Haversine.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define OP_HAVERSINE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    constexpr double DOIS_RAIOS_KM = 2.0 * RAIO_TERRA_KM;
+    
+    // Acima disso a série truncada perde precisão (termo seguinte ~1e-18 relativo em 0.1)
+    constexpr double LIMITE_SERIE = 0.1;
+    
+    // asin(h) = h + h³ · P(h²), coeficientes da série de Taylor
+    constexpr double C1 = 1.0 / 6.0;
+    constexpr double C2 = 3.0 / 40.0;
+    constexpr double C3 = 5.0 / 112.0;
+    constexpr double C4 = 35.0 / 1152.0;
+    constexpr double C5 = 63.0 / 2816.0;
+    constexpr double C6 = 231.0 / 13312.0;
+    constexpr double C7 = 143.0 / 10240.0;
+    
+    double meiaCorda(double dx, double dy, double dz) {
+        return 0.5 * std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+    
+    // h = meia corda entre a e b, h' = meia corda entre a e o antípoda de b
+    // (= cos(θ / 2)). Perto dos antípodas asin(h) amplifica o arredondamento
+    // de h; atan2(h, h') é bem condicionado no intervalo todo
+    double distanciaDaMeiaCorda(double h, const PontoEsferico& a, const PontoEsferico& b) {
+        if (h > LIMITE_SERIE) {
+            return DOIS_RAIOS_KM * std::atan2(h, meiaCorda(a.x + b.x, a.y + b.y, a.z + b.z));
+        }
+        
+        const double h2 = h * h;
+        double p = C7;
+        p = p * h2 + C6;
+        p = p * h2 + C5;
+        p = p * h2 + C4;
+        p = p * h2 + C3;
+        p = p * h2 + C2;
+        p = p * h2 + C1;
+        return DOIS_RAIOS_KM * (h + h * h2 * p);
+    }
+    
+    void distanciasEscalares(const PontoEsferico& ponto, const CoordenadasEsfericas& destinos,
+                             int inicio, int fim, double* saida) {
+        for (int j = inicio; j < fim; ++j) {
+            const PontoEsferico destino = destinos.ponto(j);
+            saida[j - inicio] = distanciaDaMeiaCorda(
+                meiaCorda(ponto.x - destino.x, ponto.y - destino.y, ponto.z - destino.z), ponto, destino);
+        }
+    }
+}
+
+#ifdef OP_HAVERSINE_X86
+
+// Falsos positivos do GCC dentro dos próprios headers de intrínsecos
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace {
+    // Mesma sequência de operações de meiaCorda + distanciaDaMeiaCorda;
+    // lanes acima do limite da série são refeitas no caminho escalar
+    __attribute__((target("avx2")))
+    void distanciasAvx2(const PontoEsferico& ponto, const CoordenadasEsfericas& destinos,
+                        int inicio, int fim, double* saida) {
+        const __m256d px = _mm256_set1_pd(ponto.x);
+        const __m256d py = _mm256_set1_pd(ponto.y);
+        const __m256d pz = _mm256_set1_pd(ponto.z);
+        const __m256d meio = _mm256_set1_pd(0.5);
+        const __m256d doisRaios = _mm256_set1_pd(DOIS_RAIOS_KM);
+        const __m256d limite = _mm256_set1_pd(LIMITE_SERIE);
+        
+        int j = inicio;
+        for (; j + 4 <= fim; j += 4) {
+            const __m256d dx = _mm256_sub_pd(px, _mm256_loadu_pd(destinos.x.data() + j));
+            const __m256d dy = _mm256_sub_pd(py, _mm256_loadu_pd(destinos.y.data() + j));
+            const __m256d dz = _mm256_sub_pd(pz, _mm256_loadu_pd(destinos.z.data() + j));
+            
+            const __m256d soma = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)),
+                                               _mm256_mul_pd(dz, dz));
+            const __m256d h = _mm256_mul_pd(meio, _mm256_sqrt_pd(soma));
+            const __m256d h2 = _mm256_mul_pd(h, h);
+            
+            __m256d p = _mm256_set1_pd(C7);
+            p = _mm256_add_pd(_mm256_mul_pd(p, h2), _mm256_set1_pd(C6));
+            p = _mm256_add_pd(_mm256_mul_pd(p, h2), _mm256_set1_pd(C5));
+            p = _mm256_add_pd(_mm256_mul_pd(p, h2), _mm256_set1_pd(C4));
+            p = _mm256_add_pd(_mm256_mul_pd(p, h2), _mm256_set1_pd(C3));
+            p = _mm256_add_pd(_mm256_mul_pd(p, h2), _mm256_set1_pd(C2));
+            p = _mm256_add_pd(_mm256_mul_pd(p, h2), _mm256_set1_pd(C1));
+            
+            const __m256d serie = _mm256_add_pd(h, _mm256_mul_pd(_mm256_mul_pd(h, h2), p));
+            _mm256_storeu_pd(saida + (j - inicio), _mm256_mul_pd(doisRaios, serie));
+            
+            const int foraDaSerie = _mm256_movemask_pd(_mm256_cmp_pd(h, limite, _CMP_GT_OQ));
+            if (foraDaSerie) {
+                distanciasEscalares(ponto, destinos, j, j + 4, saida + (j - inicio));
+            }
+        }
+        
+        distanciasEscalares(ponto, destinos, j, fim, saida + (j - inicio));
+    }
+}
+
+#endif // OP_HAVERSINE_X86
+
+void CoordenadasEsfericas::definir(const std::vector<double>& latitudesGraus,
+                                   const std::vector<double>& longitudesGraus) {
+    const std::size_t n = latitudesGraus.size();
+    x.resize(n);
+    y.resize(n);
+    z.resize(n);
+    
+    for (std::size_t i = 0; i < n; ++i) {
+        const PontoEsferico p = PontoEsferico::deGraus(latitudesGraus[i], longitudesGraus[i]);
+        x[i] = p.x;
+        y[i] = p.y;
+        z[i] = p.z;
+    }
+}
+
+double distanciaCordaKm(const PontoEsferico& a, const PontoEsferico& b) {
+    return distanciaDaMeiaCorda(meiaCorda(a.x - b.x, a.y - b.y, a.z - b.z), a, b);
+}
+
+void distanciasEmLoteKm(const PontoEsferico& ponto, const CoordenadasEsfericas& destinos,
+                        int inicio, int fim, double* saida) {
+    using Kernel = void (*)(const PontoEsferico&, const CoordenadasEsfericas&, int, int, double*);
+    
+    static const Kernel kernel = []() -> Kernel {
+#ifdef OP_HAVERSINE_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return distanciasAvx2;
+#endif
+        return distanciasEscalares;
+    }();
+    
+    kernel(ponto, destinos, inicio, fim, saida);
+}
@@ -0,0 +1,141 @@
+#ifndef INDICE_ESPACIAL_H
+#define INDICE_ESPACIAL_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// ÍNDICE ESPACIAL EM GRADE (LATITUDE x LONGITUDE)
+//
+// Os locais são distribuídos em células de mesmo tamanho em graus, com cerca
+// de um local por célula, e guardados em formato CSR (índices agrupados por
+// célula). A consulta devolve todos os locais das células que intersectam a
+// caixa de um círculo de raio r km; a caixa é conservadora para distâncias
+// de Haversine, então quem consulta só precisa filtrar pela distância exata.
+
+class IndiceEspacial {
+	public:
+	    template <typename ColecaoLocais>
+	    void construir(const ColecaoLocais& locais, double raioTerraKm) {
+	        raioTerra = raioTerraKm;
+	        const int n = static_cast<int>(locais.size());
+	        
+	        inicioCelula.clear();
+	        indices.assign(n, 0);
+	        if (n == 0) return;
+	        
+	        latitudeMinima = latitudeMaxima = locais[0].latitude;
+	        longitudeMinima = longitudeMaxima = locais[0].longitude;
+	        for (const auto& local : locais) {
+	            latitudeMinima = std::min(latitudeMinima, local.latitude);
+	            latitudeMaxima = std::max(latitudeMaxima, local.latitude);
+	            longitudeMinima = std::min(longitudeMinima, local.longitude);
+	            longitudeMaxima = std::max(longitudeMaxima, local.longitude);
+	        }
+	        
+	        // Células quadradas (em graus) com ~1 local cada
+	        const double alturaGraus = std::max(latitudeMaxima - latitudeMinima, 1e-6);
+	        const double larguraGraus = std::max(longitudeMaxima - longitudeMinima, 1e-6);
+	        tamanhoCelula = std::sqrt(alturaGraus * larguraGraus / n);
+	        tamanhoCelula = std::max({tamanhoCelula, alturaGraus / n, larguraGraus / n});
+	        
+	        linhas = static_cast<int>(alturaGraus / tamanhoCelula) + 1;
+	        colunas = static_cast<int>(larguraGraus / tamanhoCelula) + 1;
+	        
+	        // Contagem por célula e prefixo (CSR)
+	        std::vector<int> celulaDoLocal(n);
+	        inicioCelula.assign(static_cast<std::size_t>(linhas) * colunas + 1, 0);
+	        for (int i = 0; i < n; ++i) {
+	            celulaDoLocal[i] = linha(locais[i].latitude) * colunas + coluna(locais[i].longitude);
+	            ++inicioCelula[celulaDoLocal[i] + 1];
+	        }
+	        for (std::size_t c = 1; c < inicioCelula.size(); ++c) {
+	            inicioCelula[c] += inicioCelula[c - 1];
+	        }
+	        
+	        std::vector<int> posicao(inicioCelula.begin(), inicioCelula.end() - 1);
+	        for (int i = 0; i < n; ++i) {
+	            indices[posicao[celulaDoLocal[i]]++] = i;
+	        }
+	    }
+	    
+	    bool vazio() const { return inicioCelula.empty(); }
+	    
+	    // Chama visitar(indice) para todo local possivelmente a até raioKm de
+	    // (latitude, longitude), em graus
+	    template <typename Visitante>
+	    void paraCadaProximo(double latitude, double longitude, double raioKm, Visitante&& visitar) const {
+	        if (vazio() || raioKm < 0.0) return;
+	        
+	        constexpr double GRAUS_POR_RADIANO = 180.0 / M_PI;
+	        const double angulo = raioKm / raioTerra;  // Ângulo central máximo
+	        
+	        // Latitude: d >= R · |Δlat|
+	        const double deltaLatitude = angulo * GRAUS_POR_RADIANO;
+	        const double latitudeBaixa = latitude - deltaLatitude;
+	        const double latitudeAlta = latitude + deltaLatitude;
+	        
+	        // Longitude: pela fórmula de Haversine, sin(d / 2R) >=
+	        // cos(lat) · sin(|Δlon| / 2), com cos(lat) no seu mínimo da faixa
+	        const double latitudeExtrema = std::max(std::abs(latitudeBaixa), std::abs(latitudeAlta));
+	        const double cossenoMinimo = (latitudeExtrema >= 90.0) ? 0.0 : std::cos(latitudeExtrema / GRAUS_POR_RADIANO);
+	        const double seno = (angulo >= M_PI) ? 1.0 : std::sin(angulo / 2.0);
+	        
+	        double longitudeBaixa = longitudeMinima;
+	        double longitudeAlta = longitudeMaxima;
+	        if (seno < cossenoMinimo) {
+	            const double deltaLongitude = 2.0 * std::asin(seno / cossenoMinimo) * GRAUS_POR_RADIANO;
+	            // Perto do antimeridiano a caixa daria a volta: usa a faixa toda
+	            if (longitude - deltaLongitude >= -180.0 && longitude + deltaLongitude <= 180.0) {
+	                longitudeBaixa = longitude - deltaLongitude;
+	                longitudeAlta = longitude + deltaLongitude;
+	            }
+	        }
+	        
+	        if (latitudeAlta < latitudeMinima || latitudeBaixa > latitudeMaxima ||
+	            longitudeAlta < longitudeMinima || longitudeBaixa > longitudeMaxima) {
+	            return;
+	        }
+	        
+	        const int linhaInicial = linha(latitudeBaixa);
+	        const int linhaFinal = linha(latitudeAlta);
+	        const int colunaInicial = coluna(longitudeBaixa);
+	        const int colunaFinal = coluna(longitudeAlta);
+	        
+	        for (int l = linhaInicial; l <= linhaFinal; ++l) {
+	            const std::size_t primeiraCelula = static_cast<std::size_t>(l) * colunas;
+	            const int inicio = inicioCelula[primeiraCelula + colunaInicial];
+	            const int fim = inicioCelula[primeiraCelula + colunaFinal + 1];
+	            
+	            // Células consecutivas de uma linha são contíguas no CSR
+	            for (int k = inicio; k < fim; ++k) {
+	                visitar(indices[k]);
+	            }
+	        }
+	    }
+
+	private:
+	    double raioTerra = 6371.0;
+	    double latitudeMinima = 0.0, latitudeMaxima = 0.0;
+	    double longitudeMinima = 0.0, longitudeMaxima = 0.0;
+	    double tamanhoCelula = 1.0;
+	    int linhas = 0;
+	    int colunas = 0;
+	    
+	    std::vector<int> inicioCelula;  // linhas · colunas + 1
+	    std::vector<int> indices;       // Locais agrupados por célula
+	    
+	    // Limitado em double antes da conversão (raios enormes estouram int)
+	    int linha(double latitude) const {
+	        const double l = (latitude - latitudeMinima) / tamanhoCelula;
+	        return static_cast<int>(std::clamp(l, 0.0, static_cast<double>(linhas - 1)));
+	    }
+	    
+	    int coluna(double longitude) const {
+	        const double c = (longitude - longitudeMinima) / tamanhoCelula;
+	        return static_cast<int>(std::clamp(c, 0.0, static_cast<double>(colunas - 1)));
+	    }
+};
+
+#endif // INDICE_ESPACIAL_H
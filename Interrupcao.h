@@ -0,0 +1,60 @@
+#ifndef INTERRUPCAO_H
+#define INTERRUPCAO_H
+
+#include <atomic>
+#include <chrono>
+
+// PRAZO E CANCELAMENTO COOPERATIVO
+//
+// Quem dispara a consulta cria uma Interrupcao (com ou sem prazo) e a
+// aponta em ParametrosViagem::interrupcao; qualquer thread pode chamar
+// cancelar(). Os solvers consultam interrompida() entre camadas da DP,
+// passos do guloso ou blocos de nós do branch-and-bound e, ao parar,
+// devolvem a melhor rota viável que já tinham, marcada como interrompida
+// e sem garantia de otimalidade. A Interrupcao precisa viver até o fim
+// da chamada ao solver.
+
+class Interrupcao {
+	public:
+	    using Relogio = std::chrono::steady_clock;
+
+	    // Sem prazo: só para com cancelar()
+	    Interrupcao() = default;
+
+	    // externa (opcional) também interrompe: um prazo interno mais curto
+	    // não perde o cancelamento de quem chamou
+	    explicit Interrupcao(Relogio::time_point prazoFinal, const Interrupcao* interrupcaoExterna = nullptr)
+	        : possuiPrazo(true), prazo(prazoFinal), externa(interrupcaoExterna) {}
+
+	    static Interrupcao emMilissegundos(long milissegundos, const Interrupcao* interrupcaoExterna = nullptr) {
+	        return Interrupcao(Relogio::now() + std::chrono::milliseconds(milissegundos), interrupcaoExterna);
+	    }
+
+	    Interrupcao(const Interrupcao&) = delete;
+	    Interrupcao& operator=(const Interrupcao&) = delete;
+
+	    void cancelar() { cancelada.store(true, std::memory_order_relaxed); }
+
+	    // O prazo vencido fica registrado e dispensa novas leituras do relógio
+	    bool interrompida() const {
+	        if (cancelada.load(std::memory_order_relaxed)) return true;
+	        if ((externa && externa->interrompida()) || (possuiPrazo && Relogio::now() >= prazo)) {
+	            cancelada.store(true, std::memory_order_relaxed);
+	            return true;
+	        }
+	        return false;
+	    }
+
+	private:
+	    mutable std::atomic<bool> cancelada{false};
+	    bool possuiPrazo = false;
+	    Relogio::time_point prazo{};
+	    const Interrupcao* externa = nullptr;
+};
+
+// Atalho para os solvers: parâmetros sem Interrupcao nunca param
+inline bool interrompida(const Interrupcao* interrupcao) {
+    return interrupcao && interrupcao->interrompida();
+}
+
+#endif // INTERRUPCAO_H
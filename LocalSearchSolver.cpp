@@ -0,0 +1,100 @@
+#include "Solver.h"
+#include "RelogioViagem.h"
+#include "BuscaLocal.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// GULOSO + BUSCA LOCAL (2-OPT, INSERÇÃO, TROCA)
+
+namespace {
+    constexpr double EPSILON = 1e-9;
+}
+
+ResultadoSolucao OrienteeringProblemSolver::melhorarComBuscaLocal(const ResultadoSolucao& inicial,
+                                                                  const ParametrosViagem& params) const {
+    auto inicioTempo = std::chrono::high_resolution_clock::now();
+    CronometroFases cronometro;
+    
+    ResultadoSolucao resultado = inicial;
+    
+    if (!params.validar() || !inicial.solucaoValida) {
+        return resultado;
+    }
+    
+    // Sem tempo para melhorar: a rota inicial já é viável
+    if (interrompida(params.interrupcao)) {
+        resultado.interrompida = true;
+        return resultado;
+    }
+    
+    validarDados();
+    
+    const double orcamentoKm = params.orcamentoKm();
+    const auto ponteiroDistOrigem = obterDistanciasOrigem(params);
+    const std::vector<double>& distOrigem = *ponteiroDistOrigem;
+    
+    std::vector<int> pontuacoes(locais.size());
+    for (std::size_t i = 0; i < locais.size(); ++i) {
+        pontuacoes[i] = locais[i].pontuacao;
+    }
+    
+    // Os deltas da busca são em km. No modo horário ela roda com a folga em
+    // km do fator mais rápido e só é aceita se respeitar as janelas e voltar
+    // a S dentro do horário limite; senão, uma segunda tentativa não deixa a
+    // rota mais longa.
+    const bool dependenteDoTempo = modoHorario();
+    const RelogioViagem relogio(perfilVelocidade, locais, zonaLocal, params, distOrigem);
+    std::vector<double> orcamentosKm{orcamentoKm};
+    if (dependenteDoTempo) {
+        orcamentosKm = {relogio.kmAlcancaveis(relogio.partida()), inicial.custoKm};
+    }
+    
+    // Somadas às fases do solver que construiu a rota inicial
+    resultado.metricas.preparacaoNs += cronometro.marcar();
+    
+    bool aceita = false;
+    for (double orcamentoBusca : orcamentosKm) {
+        BuscaLocal busca(grafo, distOrigem, pontuacoes, orcamentoBusca);
+        std::vector<int> rota = inicial.rota;
+        busca.melhorar(rota);
+        
+        // Custo recalculado do zero: os deltas acumulam arredondamento
+        double custoRota = distOrigem[rota.front()];
+        for (std::size_t i = 1; i < rota.size(); ++i) {
+            custoRota += grafo.distancia(rota[i - 1], rota[i]);
+        }
+        custoRota += distOrigem[rota.back()];
+        
+        const double tempoRota = dependenteDoTempo
+            ? relogio.simularRota(rota, distOrigem, [&](int a, int b) { return grafo.distancia(a, b); }) - relogio.partida()
+            : custoRota / params.velocidadeKmh;
+        aceita = dependenteDoTempo ? tempoRota <= params.orcamentoHoras + EPSILON
+                                   : custoRota <= orcamentoKm + EPSILON;
+        if (!aceita) continue;
+        
+        resultado.rota = rota;
+        resultado.pontuacaoTotal = busca.pontuacao();
+        resultado.custoKm = custoRota;
+        resultado.tempoHoras = tempoRota;
+        
+        saida() << "Busca local: " << busca.movimentos2Opt << " movimentos 2-opt, "
+                << busca.realocacoes << " realocacoes, " << busca.insercoes << " insercoes, " << busca.trocas << " trocas\n";
+        break;
+    }
+    
+    if (!aceita) {
+        erros() << "AVISO: Busca local excedeu o orcamento; mantendo a rota inicial.\n";
+    }
+    resultado.metricas.transicoesNs += cronometro.marcar();
+    
+    auto fimTempo = std::chrono::high_resolution_clock::now();
+    resultado.tempoExecucaoMs = inicial.tempoExecucaoMs +
+        std::chrono::duration_cast<std::chrono::milliseconds>(fimTempo - inicioTempo).count();
+    
+    return resultado;
+}
+
+ResultadoSolucao OrienteeringProblemSolver::resolverGulosoComBuscaLocal(const ParametrosViagem& params) {
+    return melhorarComBuscaLocal(resolverGuloso(params), params);
+}
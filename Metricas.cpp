@@ -0,0 +1,67 @@
+#include "Metricas.h"
+#include <ostream>
+
+namespace {
+    struct Campo {
+        const char* nome;
+        uint64_t MetricasSolucao::* valor;
+    };
+
+    constexpr Campo FASES[] = {
+        {"preparacao", &MetricasSolucao::preparacaoNs},
+        {"transicoes", &MetricasSolucao::transicoesNs},
+        {"recuperacao", &MetricasSolucao::recuperacaoNs},
+        {"reconstrucao", &MetricasSolucao::reconstrucaoNs},
+    };
+
+    struct Serie {
+        const char* nome;
+        const char* ajuda;
+        uint64_t MetricasSolucao::* valor;
+    };
+
+    constexpr Serie CONTADORES[] = {
+        {"otimizador_estados_expandidos_total", "Estados calculados ou nos explorados",
+         &MetricasSolucao::estadosExpandidos},
+        {"otimizador_transicoes_podadas_total", "Estados ou filhos descartados pelo orcamento",
+         &MetricasSolucao::transicoesPodadas},
+        {"otimizador_candidatos_avaliados_total", "Avaliacoes de candidato do guloso",
+         &MetricasSolucao::candidatosAvaliados},
+    };
+}
+
+std::string metricasJson(const MetricasSolucao& metricas) {
+    std::string json = "{";
+    auto anexar = [&](const char* chave, uint64_t valor) {
+        if (json.size() > 1) json += ',';
+        json += '"';
+        json += chave;
+        json += "\":";
+        json += std::to_string(valor);
+    };
+
+    anexar("preparacaoNs", metricas.preparacaoNs);
+    anexar("transicoesNs", metricas.transicoesNs);
+    anexar("recuperacaoNs", metricas.recuperacaoNs);
+    anexar("reconstrucaoNs", metricas.reconstrucaoNs);
+    anexar("estadosExpandidos", metricas.estadosExpandidos);
+    anexar("transicoesPodadas", metricas.transicoesPodadas);
+    anexar("candidatosAvaliados", metricas.candidatosAvaliados);
+    return json + "}";
+}
+
+void escreverMetricasPrometheus(std::ostream& saida, const MetricasSolucao& metricas,
+                                std::string_view algoritmo) {
+    saida << "# HELP otimizador_fase_nanossegundos_total Tempo acumulado em cada fase do solver\n"
+          << "# TYPE otimizador_fase_nanossegundos_total counter\n";
+    for (const Campo& fase : FASES) {
+        saida << "otimizador_fase_nanossegundos_total{algoritmo=\"" << algoritmo << "\",fase=\""
+              << fase.nome << "\"} " << metricas.*fase.valor << "\n";
+    }
+
+    for (const Serie& serie : CONTADORES) {
+        saida << "# HELP " << serie.nome << ' ' << serie.ajuda << "\n"
+              << "# TYPE " << serie.nome << " counter\n"
+              << serie.nome << "{algoritmo=\"" << algoritmo << "\"} " << metricas.*serie.valor << "\n";
+    }
+}
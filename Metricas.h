@@ -0,0 +1,103 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+// MÉTRICAS DOS SOLVERS
+//
+// Cada ResultadoSolucao traz o tempo de cada fase em nanossegundos e os
+// contadores do laço interno. A coleta é ligada pela opção de CMake
+// OTIMIZADOR_METRICAS (padrão ON); desligada, CronometroFases e Contador
+// ficam vazios, marcar() e total() devolvem 0 constante e o compilador
+// elimina tudo do caminho quente. A estrutura continua existindo para que
+// quem exporta não dependa da opção: tempos e contadores do laço interno
+// ficam zerados, e só sobram as contagens que o solver já mantinha (passos
+// do guloso, nós do branch-and-bound, iterações do GRASP).
+//
+// Fases, na ordem em que os solvers as atravessam:
+//   preparacao   - validação, distâncias da origem, alocação e caso base
+//   transicoes   - expansão dos estados (a DP densa já avalia os fechamentos aqui)
+//   recuperacao  - escolha do melhor estado fechado
+//   reconstrucao - rota a partir dos predecessores e validação final
+
+#ifndef OTIMIZADOR_METRICAS
+#define OTIMIZADOR_METRICAS 1
+#endif
+
+struct MetricasSolucao {
+    uint64_t preparacaoNs = 0;
+    uint64_t transicoesNs = 0;
+    uint64_t recuperacaoNs = 0;
+    uint64_t reconstrucaoNs = 0;
+
+    uint64_t estadosExpandidos = 0;    // Estados calculados (DP) ou nós/passos (BB, guloso)
+    uint64_t transicoesPodadas = 0;    // Estados ou filhos descartados pelo orçamento
+    uint64_t candidatosAvaliados = 0;  // Avaliações de candidato do guloso
+
+    MetricasSolucao& operator+=(const MetricasSolucao& outra) {
+        preparacaoNs += outra.preparacaoNs;
+        transicoesNs += outra.transicoesNs;
+        recuperacaoNs += outra.recuperacaoNs;
+        reconstrucaoNs += outra.reconstrucaoNs;
+        estadosExpandidos += outra.estadosExpandidos;
+        transicoesPodadas += outra.transicoesPodadas;
+        candidatosAvaliados += outra.candidatosAvaliados;
+        return *this;
+    }
+};
+
+#if OTIMIZADOR_METRICAS
+
+// Nanossegundos desde a marca anterior (ou desde a construção)
+class CronometroFases {
+	public:
+	    CronometroFases() : marca(std::chrono::steady_clock::now()) {}
+
+	    uint64_t marcar() {
+	        const auto agora = std::chrono::steady_clock::now();
+	        const auto decorrido = std::chrono::duration_cast<std::chrono::nanoseconds>(agora - marca).count();
+	        marca = agora;
+	        return static_cast<uint64_t>(decorrido);
+	    }
+
+	private:
+	    std::chrono::steady_clock::time_point marca;
+};
+
+// Contador local de uma thread; somado às métricas ao fim da fase
+class Contador {
+	public:
+	    void somar(uint64_t quantidade = 1) { valor += quantidade; }
+	    uint64_t total() const { return valor; }
+
+	private:
+	    uint64_t valor = 0;
+};
+
+#else
+
+class CronometroFases {
+	public:
+	    uint64_t marcar() { return 0; }
+};
+
+class Contador {
+	public:
+	    void somar(uint64_t = 1) {}
+	    uint64_t total() const { return 0; }
+};
+
+#endif
+
+// Objeto JSON plano, no formato do protocolo do servidor
+std::string metricasJson(const MetricasSolucao& metricas);
+
+// Formato texto do Prometheus, com o algoritmo como rótulo
+void escreverMetricasPrometheus(std::ostream& saida, const MetricasSolucao& metricas,
+                                std::string_view algoritmo);
+
+#endif // METRICAS_H
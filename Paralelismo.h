@@ -0,0 +1,83 @@
+#ifndef PARALELISMO_H
+#define PARALELISMO_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// UTILITÁRIOS DE PARALELISMO
+
+// Número efetivo de threads: 0 significa "todos os núcleos disponíveis"
+inline int resolverNumeroThreads(int solicitado) {
+    if (solicitado > 0) return solicitado;
+    const unsigned int disponiveis = std::thread::hardware_concurrency();
+    return disponiveis > 0 ? static_cast<int>(disponiveis) : 1;
+}
+
+// Barreira reutilizável (equivalente ao std::barrier do C++20)
+class Barreira {
+	public:
+	    explicit Barreira(int participantes) : total(participantes), restantes(participantes) {}
+
+	    void aguardar() {
+	        std::unique_lock<std::mutex> trava(mutex);
+	        const std::size_t geracaoAtual = geracao;
+
+	        if (--restantes == 0) {
+	            restantes = total;
+	            ++geracao;
+	            condicao.notify_all();
+	            return;
+	        }
+
+	        condicao.wait(trava, [&] { return geracao != geracaoAtual; });
+	    }
+
+	private:
+	    std::mutex mutex;
+	    std::condition_variable condicao;
+	    const int total;
+	    int restantes;
+	    std::size_t geracao = 0;
+};
+
+// Executa tarefa(idThread) em numThreads threads (a thread chamadora é a 0)
+// e aguarda todas terminarem. Uma exceção numa tarefa não derruba o
+// processo: todas as threads são aguardadas e a primeira exceção (pela
+// ordem das threads) é relançada na chamadora. Tarefas que sincronizam por
+// Barreira não podem lançar entre barreiras, ou as demais esperam para sempre.
+template <typename Tarefa>
+void executarEmParalelo(int numThreads, Tarefa&& tarefa) {
+    numThreads = std::max(1, numThreads);
+
+    std::vector<std::exception_ptr> excecoes(numThreads);
+    auto executar = [&tarefa, &excecoes](int t) {
+        try {
+            tarefa(t);
+        } catch (...) {
+            excecoes[t] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (int t = 1; t < numThreads; ++t) {
+        threads.emplace_back(executar, t);
+    }
+
+    executar(0);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const std::exception_ptr& excecao : excecoes) {
+        if (excecao) std::rethrow_exception(excecao);
+    }
+}
+
+#endif // PARALELISMO_H
@@ -0,0 +1,134 @@
+#ifndef PERFIL_VELOCIDADE_H
+#define PERFIL_VELOCIDADE_H
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+// PERFIL DE VELOCIDADE DEPENDENTE DO HORÁRIO
+//
+// O dia é dividido em faixas de mesma duração (por exemplo, 24 faixas de
+// 1 h, repetidas ciclicamente). Em cada faixa a velocidade é constante e
+// igual à velocidade base da consulta vezes um fator da faixa. O tempo de
+// viagem de uma aresta é obtido integrando a distância ao longo das faixas
+// que ela atravessa (modelo de Ichoua, Gendreau e Potvin): o resultado é
+// linear por partes no horário de partida e respeita FIFO, isto é, sair
+// mais tarde nunca faz chegar mais cedo. Com FIFO, o horário de chegada
+// mais cedo domina os demais e os solvers podem guardar só ele por estado.
+//
+// Zonas opcionais (caixas de latitude/longitude) têm fatores próprios; a
+// aresta usa a zona do seu ponto de partida. Fora de qualquer caixa vale a
+// zona 0. A tabela de fatores é uma matriz zonas x faixas contígua.
+
+struct CaixaZona {
+    double latitudeMinima;
+    double latitudeMaxima;
+    double longitudeMinima;
+    double longitudeMaxima;
+
+    bool contem(double latitude, double longitude) const {
+        return latitude >= latitudeMinima && latitude <= latitudeMaxima &&
+               longitude >= longitudeMinima && longitude <= longitudeMaxima;
+    }
+};
+
+class PerfilVelocidade {
+	public:
+	    // Perfil vazio: velocidade constante (os solvers usam distância / velocidade)
+	    PerfilVelocidade() = default;
+
+	    // Fatores da zona 0, um por faixa de duracaoFaixaHoras
+	    PerfilVelocidade(double duracaoFaixaHoras, const std::vector<double>& fatoresZonaPadrao)
+	        : duracaoFaixa(duracaoFaixaHoras), numFaixas(static_cast<int>(fatoresZonaPadrao.size()))
+	    {
+	        if (!(duracaoFaixa > 0.0) || numFaixas == 0) {
+	            throw std::runtime_error("Perfil de velocidade precisa de faixas com duracao positiva");
+	        }
+	        adicionarFatores(fatoresZonaPadrao);
+	    }
+
+	    // Nova zona (índice devolvido); caixas sobrepostas ficam com a primeira
+	    int adicionarZona(const CaixaZona& caixa, const std::vector<double>& fatores) {
+	        if (vazio()) {
+	            throw std::runtime_error("Defina os fatores da zona padrao antes das demais zonas");
+	        }
+	        if (static_cast<int>(fatores.size()) != numFaixas) {
+	            throw std::runtime_error("Zona com numero de faixas diferente do perfil");
+	        }
+	        caixas.push_back(caixa);
+	        adicionarFatores(fatores);
+	        return static_cast<int>(caixas.size());
+	    }
+
+	    bool vazio() const { return numFaixas == 0; }
+
+	    int zona(double latitude, double longitude) const {
+	        for (std::size_t i = 0; i < caixas.size(); ++i) {
+	            if (caixas[i].contem(latitude, longitude)) return static_cast<int>(i) + 1;
+	        }
+	        return 0;
+	    }
+
+	    // Maior fator em qualquer zona e faixa: limita a distância alcançável
+	    double fatorMaximo() const { return maiorFator; }
+
+	    // Horário de chegada (horas) ao percorrer distanciaKm a partir de
+	    // partidaHoras. Custo proporcional ao número de faixas atravessadas,
+	    // com ciclos completos pulados de uma vez.
+	    double chegada(double partidaHoras, double distanciaKm, double velocidadeBaseKmh, int zona) const {
+	        if (!std::isfinite(partidaHoras)) return partidaHoras;
+	        const double* fatoresZona = fatores.data() + static_cast<std::size_t>(zona) * numFaixas;
+
+	        // Distância restante em horas à velocidade base: numa faixa de
+	        // fator f, cada hora de relógio consome f dessas horas
+	        double restante = distanciaKm / velocidadeBaseKmh;
+	        double horario = partidaHoras;
+
+	        const double horasBasePorCiclo = horasBaseCiclo[zona];
+	        if (restante >= horasBasePorCiclo) {
+	            const double ciclos = std::floor(restante / horasBasePorCiclo);
+	            horario += ciclos * duracaoFaixa * numFaixas;
+	            restante -= ciclos * horasBasePorCiclo;
+	        }
+
+	        double numeroFaixa = std::floor(horario / duracaoFaixa);
+	        int faixa = static_cast<int>(numeroFaixa - std::floor(numeroFaixa / numFaixas) * numFaixas);
+
+	        while (true) {
+	            const double fimFaixa = (numeroFaixa + 1.0) * duracaoFaixa;
+	            const double capacidade = (fimFaixa - horario) * fatoresZona[faixa];
+	            if (restante <= capacidade) {
+	                return horario + restante / fatoresZona[faixa];
+	            }
+
+	            restante -= capacidade;
+	            horario = fimFaixa;
+	            numeroFaixa += 1.0;
+	            if (++faixa == numFaixas) faixa = 0;
+	        }
+	    }
+
+	private:
+	    double duracaoFaixa = 0.0;
+	    int numFaixas = 0;
+	    double maiorFator = 0.0;
+	    std::vector<double> fatores;           // zonas x faixas
+	    std::vector<double> horasBaseCiclo;    // Distância (em horas base) coberta num ciclo, por zona
+	    std::vector<CaixaZona> caixas;         // Zona i + 1 = caixas[i]
+
+	    void adicionarFatores(const std::vector<double>& fatoresZona) {
+	        double soma = 0.0;
+	        for (double fator : fatoresZona) {
+	            if (!(fator > 0.0) || !std::isfinite(fator)) {
+	                throw std::runtime_error("Fatores de velocidade devem ser positivos");
+	            }
+	            soma += fator;
+	            if (fator > maiorFator) maiorFator = fator;
+	        }
+	        fatores.insert(fatores.end(), fatoresZona.begin(), fatoresZona.end());
+	        horasBaseCiclo.push_back(soma * duracaoFaixa);
+	    }
+};
+
+#endif // PERFIL_VELOCIDADE_H
@@ -0,0 +1,105 @@
+#ifndef RELOGIO_VIAGEM_H
+#define RELOGIO_VIAGEM_H
+
+#include "Solver.h"
+#include "EspacoTrabalho.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+// RELÓGIO DA ROTA NO MODO HORÁRIO
+//
+// Com perfil de velocidade ou locais com visita/janela, o custo de um estado
+// é o horário. viajar() leva o horário de saída ao de chegada; visitar()
+// espera a abertura, soma a duração e devolve o horário de saída, ou
+// INFINITO se a visita não terminar até o fechamento. As duas funções são
+// não decrescentes (FIFO), então o horário mais cedo de cada estado domina.
+//
+// ultimaSaida[i] é o último horário em que se pode deixar i e ainda voltar a
+// S até o limite: nenhum caminho de i a S é mais curto que d(i, S) nem mais
+// rápido que o fator máximo do perfil. visitar() já descarta saídas depois
+// dele, o que poda estados sem volta possível logo na transição. O vetor
+// sai da arena da thread e é devolvido quando o relógio sai de escopo.
+
+class RelogioViagem {
+	public:
+	    static constexpr double INFINITO = std::numeric_limits<double>::infinity();
+
+	    RelogioViagem(const PerfilVelocidade& perfil,
+	                  const std::vector<Local>& locais,
+	                  const std::vector<int>& zonaLocal,
+	                  const ParametrosViagem& params,
+	                  const std::vector<double>& distOrigem)
+	        : perfil(perfil), locais(locais), zonaLocal(zonaLocal),
+	          velocidadeKmh(params.velocidadeKmh),
+	          kmPorHoraMaximo(params.velocidadeKmh * (perfil.vazio() ? 1.0 : perfil.fatorMaximo())),
+	          horaPartida(params.horaPartida),
+	          limiteVolta(params.horaPartida + params.orcamentoHoras),
+	          zonaOrigem(perfil.vazio() ? 0 : perfil.zona(params.latitudePartida, params.longitudePartida)),
+	          escopoArena(EspacoTrabalho::daThread().arena),
+	          ultimaSaida(EspacoTrabalho::daThread().arena.alocar<double>(locais.size()))
+	    {
+	        for (std::size_t i = 0; i < locais.size(); ++i) {
+	            ultimaSaida[i] = limiteVolta - distOrigem[i] / kmPorHoraMaximo;
+	        }
+	    }
+
+	    double partida() const { return horaPartida; }
+	    double limite() const { return limiteVolta; }
+
+	    // Horário de chegada ao percorrer distanciaKm saindo de u (-1 = origem S)
+	    double viajar(double horario, double distanciaKm, int u) const {
+	        if (perfil.vazio()) return horario + distanciaKm / velocidadeKmh;
+	        return perfil.chegada(horario, distanciaKm, velocidadeKmh, u < 0 ? zonaOrigem : zonaLocal[u]);
+	    }
+
+	    // Horário de saída de v para uma chegada em 'chegada' (INFINITO se inviável)
+	    double visitar(int v, double chegada) const {
+	        const Local& local = locais[v];
+	        const double saida = std::max(chegada, local.aberturaHoras) + local.duracaoVisitaHoras;
+	        if (saida > local.fechamentoHoras + TOLERANCIA || saida > ultimaSaida[v] + TOLERANCIA) {
+	            return INFINITO;
+	        }
+	        return saida;
+	    }
+
+	    // Chegando em 'horario' ou depois, v nunca mais cabe (o relógio só avança)
+	    bool descartavel(int v, double horario) const {
+	        return visitar(v, horario) == INFINITO;
+	    }
+
+	    // Horário de volta a S ao fim da rota (INFINITO se alguma visita falhar)
+	    template <typename Distancia>
+	    double simularRota(const std::vector<int>& rota, const std::vector<double>& distOrigem,
+	                       Distancia distancia) const {
+	        double horario = horaPartida;
+	        int anterior = -1;
+	        for (int local : rota) {
+	            const double distanciaKm = (anterior == -1) ? distOrigem[local] : distancia(anterior, local);
+	            horario = visitar(local, viajar(horario, distanciaKm, anterior));
+	            if (horario == INFINITO) return INFINITO;
+	            anterior = local;
+	        }
+	        return viajar(horario, distOrigem[anterior], anterior);
+	    }
+
+	    // Limitantes para podas: horas mínimas por km e km alcançáveis até o limite
+	    double horasPorKmMinimo() const { return 1.0 / kmPorHoraMaximo; }
+	    double kmAlcancaveis(double horario) const { return (limiteVolta - horario) * kmPorHoraMaximo; }
+
+	private:
+	    static constexpr double TOLERANCIA = 2e-9;  // Mais larga que o EPSILON dos solvers
+
+	    const PerfilVelocidade& perfil;
+	    const std::vector<Local>& locais;
+	    const std::vector<int>& zonaLocal;
+	    const double velocidadeKmh;
+	    const double kmPorHoraMaximo;
+	    const double horaPartida;
+	    const double limiteVolta;
+	    const int zonaOrigem;
+	    ArenaTrabalho::Escopo escopoArena;
+	    double* const ultimaSaida;
+};
+
+#endif // RELOGIO_VIAGEM_H
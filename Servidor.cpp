@@ -0,0 +1,911 @@
+#include "Servidor.h"
+#include "Paralelismo.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    constexpr std::size_t TAMANHO_MAXIMO_LINHA = 64 * 1024;
+    constexpr std::size_t TAMANHO_MAXIMO_FILA = 4096;   // Leitores esperam acima disso
+    constexpr int PENDENTES_MAXIMOS_CONEXAO = 1024;     // Consultas sem resposta por conexão
+    constexpr int EM_VOO_MAXIMO_CLIENTE = 256;          // Requisições e respostas cabem nos buffers do socket
+    constexpr int INTERVALO_POLL_MS = 200;
+    constexpr auto TEMPO_MAXIMO_SEM_ENVIO = std::chrono::seconds(5);  // Cliente que não lê é desconectado
+
+    // Limites dos campos opcionais, para que as conversões não estourem
+    constexpr double MEMORIA_DP_MAXIMA_MB = 1024.0 * 1024.0;      // 1 TiB
+    constexpr double PRAZO_MAXIMO_MS = 24.0 * 60.0 * 60.0 * 1000.0;  // Um dia
+
+    std::atomic<bool> sinalEncerrar(false);
+
+    void tratarSinal(int) {
+        sinalEncerrar.store(true);
+    }
+
+    // ENDEREÇOS
+
+    bool enderecoTcp(const std::string& endereco) {
+        return !endereco.empty() && std::all_of(endereco.begin(), endereco.end(),
+                                                [](char c) { return c >= '0' && c <= '9'; });
+    }
+
+    std::runtime_error erroSistema(const std::string& operacao) {
+        return std::runtime_error(operacao + ": " + std::strerror(errno));
+    }
+
+    sockaddr_un enderecoUnix(const std::string& caminho) {
+        sockaddr_un endereco{};
+        if (caminho.size() >= sizeof(endereco.sun_path)) {
+            throw std::runtime_error("Caminho de socket muito longo: " + caminho);
+        }
+        endereco.sun_family = AF_UNIX;
+        std::memcpy(endereco.sun_path, caminho.c_str(), caminho.size() + 1);
+        return endereco;
+    }
+
+    sockaddr_in enderecoLocalTcp(const std::string& porta) {
+        sockaddr_in endereco{};
+        endereco.sin_family = AF_INET;
+        endereco.sin_port = htons(static_cast<uint16_t>(std::stoi(porta)));
+        endereco.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return endereco;
+    }
+
+    void desativarNagle(int fd) {
+        const int um = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &um, sizeof(um));
+    }
+
+    int abrirSocketEscuta(const std::string& endereco) {
+        const bool tcp = enderecoTcp(endereco);
+        const int fd = socket(tcp ? AF_INET : AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) throw erroSistema("socket");
+
+        int resultado;
+        if (tcp) {
+            const int um = 1;
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &um, sizeof(um));
+            const sockaddr_in local = enderecoLocalTcp(endereco);
+            resultado = bind(fd, reinterpret_cast<const sockaddr*>(&local), sizeof(local));
+        } else {
+            const sockaddr_un local = enderecoUnix(endereco);
+            unlink(endereco.c_str());  // Socket de uma execução anterior
+            resultado = bind(fd, reinterpret_cast<const sockaddr*>(&local), sizeof(local));
+        }
+
+        if (resultado < 0 || listen(fd, SOMAXCONN) < 0) {
+            const auto erro = erroSistema("bind/listen em " + endereco);
+            close(fd);
+            throw erro;
+        }
+        return fd;
+    }
+
+    int conectar(const std::string& endereco) {
+        const bool tcp = enderecoTcp(endereco);
+        const int fd = socket(tcp ? AF_INET : AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) throw erroSistema("socket");
+
+        int resultado;
+        if (tcp) {
+            const sockaddr_in remoto = enderecoLocalTcp(endereco);
+            resultado = connect(fd, reinterpret_cast<const sockaddr*>(&remoto), sizeof(remoto));
+            desativarNagle(fd);
+        } else {
+            const sockaddr_un remoto = enderecoUnix(endereco);
+            resultado = connect(fd, reinterpret_cast<const sockaddr*>(&remoto), sizeof(remoto));
+        }
+
+        if (resultado < 0) {
+            const auto erro = erroSistema("connect em " + endereco);
+            close(fd);
+            throw erro;
+        }
+        return fd;
+    }
+
+    bool enviarTudo(int fd, const char* dados, std::size_t tamanho) {
+        while (tamanho > 0) {
+            const ssize_t enviados = send(fd, dados, tamanho, MSG_NOSIGNAL);
+            if (enviados < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            dados += enviados;
+            tamanho -= static_cast<std::size_t>(enviados);
+        }
+        return true;
+    }
+
+    // JSON MÍNIMO
+    //
+    // Só o necessário para o protocolo: um objeto plano com números, textos,
+    // booleanos e null. Objetos e listas aninhados são recusados.
+
+    struct ValorJson {
+        enum class Tipo { Numero, Texto, Booleano, Nulo } tipo = Tipo::Nulo;
+        double numero = 0.0;
+        bool booleano = false;
+        std::string texto;
+        std::string_view bruto;  // Trecho original, para devolver o "id" como veio
+    };
+
+    class LeitorJson {
+    public:
+        explicit LeitorJson(std::string_view texto) : texto(texto) {}
+
+        // Chama campo(chave, valor) para cada par do objeto
+        template <typename Campo>
+        bool lerObjeto(Campo&& campo, std::string& erro) {
+            pularEspacos();
+            if (!consumir('{')) return falhar(erro, "esperado '{'");
+
+            pularEspacos();
+            if (consumir('}')) return fimDoTexto(erro);
+
+            while (true) {
+                std::string chave;
+                ValorJson valor;
+
+                pularEspacos();
+                if (!lerTexto(chave)) return falhar(erro, "chave invalida");
+                pularEspacos();
+                if (!consumir(':')) return falhar(erro, "esperado ':'");
+                pularEspacos();
+                if (!lerValor(valor)) return falhar(erro, "valor invalido em \"" + chave + "\"");
+
+                campo(chave, valor);
+
+                pularEspacos();
+                if (consumir('}')) return fimDoTexto(erro);
+                if (!consumir(',')) return falhar(erro, "esperado ',' ou '}'");
+            }
+        }
+
+    private:
+        std::string_view texto;
+        std::size_t posicao = 0;
+
+        bool falhar(std::string& erro, const std::string& mensagem) {
+            erro = "JSON invalido (posicao " + std::to_string(posicao) + "): " + mensagem;
+            return false;
+        }
+
+        bool fimDoTexto(std::string& erro) {
+            pularEspacos();
+            return posicao == texto.size() || falhar(erro, "texto apos o objeto");
+        }
+
+        void pularEspacos() {
+            while (posicao < texto.size() &&
+                   (texto[posicao] == ' ' || texto[posicao] == '\t' || texto[posicao] == '\r' || texto[posicao] == '\n')) {
+                ++posicao;
+            }
+        }
+
+        bool consumir(char esperado) {
+            if (posicao < texto.size() && texto[posicao] == esperado) {
+                ++posicao;
+                return true;
+            }
+            return false;
+        }
+
+        bool consumirLiteral(std::string_view literal) {
+            if (texto.substr(posicao, literal.size()) != literal) return false;
+            posicao += literal.size();
+            return true;
+        }
+
+        bool lerTexto(std::string& saida) {
+            if (!consumir('"')) return false;
+
+            while (posicao < texto.size()) {
+                const char c = texto[posicao++];
+                if (c == '"') return true;
+                if (c != '\\') {
+                    saida += c;
+                    continue;
+                }
+
+                if (posicao >= texto.size()) return false;
+                switch (texto[posicao++]) {
+                    case '"':  saida += '"'; break;
+                    case '\\': saida += '\\'; break;
+                    case '/':  saida += '/'; break;
+                    case 'b':  saida += '\b'; break;
+                    case 'f':  saida += '\f'; break;
+                    case 'n':  saida += '\n'; break;
+                    case 'r':  saida += '\r'; break;
+                    case 't':  saida += '\t'; break;
+                    case 'u': {
+                        // Nomes de catálogo e algoritmo são ASCII; o resto vira '?'
+                        unsigned int codigo = 0;
+                        const char* inicio = texto.data() + posicao;
+                        if (posicao + 4 > texto.size() ||
+                            std::from_chars(inicio, inicio + 4, codigo, 16).ptr != inicio + 4) {
+                            return false;
+                        }
+                        posicao += 4;
+                        saida += (codigo < 0x80) ? static_cast<char>(codigo) : '?';
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+            }
+            return false;
+        }
+
+        bool lerValor(ValorJson& valor) {
+            const std::size_t inicio = posicao;
+
+            if (posicao < texto.size() && texto[posicao] == '"') {
+                valor.tipo = ValorJson::Tipo::Texto;
+                if (!lerTexto(valor.texto)) return false;
+            } else if (consumirLiteral("true") || consumirLiteral("false")) {
+                valor.tipo = ValorJson::Tipo::Booleano;
+                valor.booleano = texto[inicio] == 't';
+            } else if (consumirLiteral("null")) {
+                valor.tipo = ValorJson::Tipo::Nulo;
+            } else {
+                const char* primeiro = texto.data() + posicao;
+                const char* fim = texto.data() + texto.size();
+                const auto [ultimo, erro] = std::from_chars(primeiro, fim, valor.numero);
+                // from_chars aceita "nan" e "inf", que não são JSON
+                if (erro != std::errc() || ultimo == primeiro || !std::isfinite(valor.numero)) return false;
+                valor.tipo = ValorJson::Tipo::Numero;
+                posicao += static_cast<std::size_t>(ultimo - primeiro);
+            }
+
+            valor.bruto = texto.substr(inicio, posicao - inicio);
+            return true;
+        }
+    };
+
+    void anexarTextoJson(std::string& saida, std::string_view texto) {
+        saida += '"';
+        for (char c : texto) {
+            if (c == '"' || c == '\\') {
+                saida += '\\';
+                saida += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char escape[8];
+                std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned char>(c));
+                saida += escape;
+            } else {
+                saida += c;
+            }
+        }
+        saida += '"';
+    }
+
+    void anexarDecimal(std::string& saida, double valor) {
+        char numero[32];
+        std::snprintf(numero, sizeof(numero), "%.3f", valor);
+        saida += numero;
+    }
+
+    // PROTOCOLO
+
+    struct Requisicao {
+        std::string id = "null";
+        ParametrosViagem params{0.0, 0.0, 0.0, 0.0};
+        std::string algoritmo = "guloso";
+        std::string qualidade = "otima";  // Só para "auto"
+        std::string catalogo;
+        double memoriaDPMB = 0.0;
+        double prazoMs = 0.0;  // 0 = sem prazo
+        bool metricas = false;
+    };
+
+    bool interpretarRequisicao(std::string_view linha, Requisicao& requisicao, std::string& erro) {
+        int obrigatorios = 0;
+        std::string campoInvalido;
+
+        auto campo = [&](const std::string& chave, const ValorJson& valor) {
+            const bool numero = valor.tipo == ValorJson::Tipo::Numero;
+            const bool texto = valor.tipo == ValorJson::Tipo::Texto;
+
+            if (chave == "id") {
+                requisicao.id = std::string(valor.bruto);
+                return;
+            }
+
+            double* destino = nullptr;
+            if (chave == "latitude") destino = &requisicao.params.latitudePartida;
+            else if (chave == "longitude") destino = &requisicao.params.longitudePartida;
+            else if (chave == "orcamentoHoras") destino = &requisicao.params.orcamentoHoras;
+            else if (chave == "velocidadeKmh") destino = &requisicao.params.velocidadeKmh;
+
+            if (destino) {
+                if (!numero) campoInvalido = chave;
+                *destino = valor.numero;
+                ++obrigatorios;
+            } else if (chave == "horaPartida" || chave == "memoriaDPMB" || chave == "prazoMs") {
+                if (!numero) campoInvalido = chave;
+                (chave == "horaPartida" ? requisicao.params.horaPartida
+                 : chave == "memoriaDPMB" ? requisicao.memoriaDPMB : requisicao.prazoMs) = valor.numero;
+            } else if (chave == "algoritmo" || chave == "catalogo" || chave == "qualidade") {
+                if (!texto) campoInvalido = chave;
+                (chave == "algoritmo" ? requisicao.algoritmo
+                 : chave == "catalogo" ? requisicao.catalogo : requisicao.qualidade) = valor.texto;
+            } else if (chave == "metricas") {
+                if (valor.tipo != ValorJson::Tipo::Booleano) campoInvalido = chave;
+                requisicao.metricas = valor.booleano;
+            }
+            // Chaves desconhecidas são ignoradas
+        };
+
+        if (!LeitorJson(linha).lerObjeto(campo, erro)) return false;
+
+        if (!campoInvalido.empty()) {
+            erro = "Tipo invalido no campo \"" + campoInvalido + "\"";
+            return false;
+        }
+        if (obrigatorios != 4) {
+            erro = "Campos obrigatorios: latitude, longitude, orcamentoHoras, velocidadeKmh";
+            return false;
+        }
+        return true;
+    }
+
+    std::string respostaErro(const std::string& id, const std::string& mensagem) {
+        std::string resposta = "{\"id\":" + id + ",\"erro\":";
+        anexarTextoJson(resposta, mensagem);
+        resposta += '}';
+        return resposta;
+    }
+}
+
+// CONEXÃO
+//
+// Compartilhada entre a thread leitora e os workers com respostas
+// pendentes; o socket fecha quando a última referência sai. Os workers
+// nunca bloqueiam no envio: o que o socket não aceita na hora fica em
+// "saida" e a leitora escreve quando ele volta a aceitar. Enquanto houver
+// saída acumulada (ou consultas demais sem resposta) a leitora para de ler,
+// então um cliente que não lê as respostas só segura a própria conexão, e
+// a saída fica limitada às respostas das consultas já aceitas.
+
+struct ServidorSolver::Conexao {
+    const int fd;
+    const int evento;          // eventfd: acorda a leitora quando algo muda
+    std::mutex mutexSaida;
+    std::string saida;         // Bytes que o socket ainda não aceitou
+    int pendentes = 0;         // Consultas enfileiradas e ainda sem resposta
+    bool aberta = true;
+
+    explicit Conexao(int descritor) : fd(descritor), evento(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {}
+    ~Conexao() {
+        close(fd);
+        if (evento >= 0) close(evento);
+    }
+
+    bool ativa() {
+        std::lock_guard<std::mutex> trava(mutexSaida);
+        return aberta;
+    }
+
+    void reservar() {
+        std::lock_guard<std::mutex> trava(mutexSaida);
+        ++pendentes;
+    }
+
+    // Resposta de uma consulta reservada
+    void concluir(const std::string& dados) {
+        {
+            std::lock_guard<std::mutex> trava(mutexSaida);
+            --pendentes;
+            escrever(dados);
+        }
+        acordar();
+    }
+
+    void enviar(const std::string& dados) {
+        {
+            std::lock_guard<std::mutex> trava(mutexSaida);
+            escrever(dados);
+        }
+        acordar();
+    }
+
+    // Escreve o que o socket aceitar da saída acumulada; false se a conexão caiu
+    bool descarregar(bool& progrediu) {
+        std::lock_guard<std::mutex> trava(mutexSaida);
+        const std::size_t antes = saida.size();
+        if (aberta) enviarSemBloquear();
+        progrediu = saida.size() < antes;
+        return aberta;
+    }
+
+    void acordar() {
+        const uint64_t um = 1;
+        if (evento >= 0) (void)write(evento, &um, sizeof(um));
+    }
+
+    // Cliente foi embora ou parou de ler: respostas restantes são descartadas
+    void fechar() {
+        std::lock_guard<std::mutex> trava(mutexSaida);
+        fecharTravado();
+    }
+
+private:
+    void escrever(const std::string& dados) {
+        if (!aberta) return;
+        saida += dados;
+        if (saida.size() == dados.size()) enviarSemBloquear();  // Sem fila à frente
+    }
+
+    void enviarSemBloquear() {
+        std::size_t enviados = 0;
+        while (enviados < saida.size()) {
+            const ssize_t resultado = send(fd, saida.data() + enviados, saida.size() - enviados,
+                                           MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (resultado < 0) {
+                if (errno == EINTR) continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK) fecharTravado();
+                break;
+            }
+            enviados += static_cast<std::size_t>(resultado);
+        }
+        saida.erase(0, enviados);
+    }
+
+    void fecharTravado() {
+        if (!aberta) return;
+        aberta = false;
+        std::string().swap(saida);
+        shutdown(fd, SHUT_RDWR);
+    }
+};
+
+ServidorSolver::ServidorSolver(int numWorkers) : numWorkers(resolverNumeroThreads(numWorkers)) {}
+
+ServidorSolver::~ServidorSolver() {
+    encerrar();
+}
+
+void ServidorSolver::adicionarCatalogo(const std::string& nome, std::unique_ptr<OrienteeringProblemSolver> solver) {
+    if (catalogos.empty()) catalogoPadrao = nome;
+    solver->definirSilencioso(true);
+    catalogos[nome] = std::move(solver);
+}
+
+std::string ServidorSolver::responder(std::string_view linha) const {
+    Requisicao requisicao;
+    std::string erro;
+    if (!interpretarRequisicao(linha, requisicao, erro)) {
+        return respostaErro(requisicao.id, erro);
+    }
+
+    const std::string& nomeCatalogo = requisicao.catalogo.empty() ? catalogoPadrao : requisicao.catalogo;
+    const auto catalogo = catalogos.find(nomeCatalogo);
+    if (catalogo == catalogos.end()) {
+        return respostaErro(requisicao.id, "Catalogo desconhecido: " + nomeCatalogo);
+    }
+
+    Algoritmo algoritmo;
+    if (!interpretarAlgoritmo(requisicao.algoritmo, algoritmo)) {
+        return respostaErro(requisicao.id, "Algoritmo desconhecido: " + requisicao.algoritmo);
+    }
+    if (!catalogo->second->suportaAlgoritmo(algoritmo)) {
+        return respostaErro(requisicao.id, std::string(nomeAlgoritmo(algoritmo)) +
+                            " nao segue visitas, janelas nem perfil de velocidade do catalogo " +
+                            nomeCatalogo + "; use dp, guloso, guloso-bl ou auto");
+    }
+    QualidadeAlvo qualidade;
+    if (!interpretarQualidade(requisicao.qualidade, qualidade)) {
+        return respostaErro(requisicao.id, "Qualidade desconhecida: " + requisicao.qualidade);
+    }
+    if (!requisicao.params.validar() || requisicao.memoriaDPMB < 0.0 || requisicao.prazoMs < 0.0) {
+        return respostaErro(requisicao.id, "Parametros de viagem invalidos");
+    }
+    if (requisicao.memoriaDPMB > MEMORIA_DP_MAXIMA_MB) {
+        return respostaErro(requisicao.id, "memoriaDPMB acima do limite de " +
+                            std::to_string(static_cast<long long>(MEMORIA_DP_MAXIMA_MB)) + " MB");
+    }
+    if (requisicao.prazoMs > PRAZO_MAXIMO_MS) {
+        return respostaErro(requisicao.id, "prazoMs acima do limite de " +
+                            std::to_string(static_cast<long long>(PRAZO_MAXIMO_MS)) + " ms");
+    }
+
+    // Cada worker já é uma thread: a DP não abre outras
+    OpcoesDP opcoesDP;
+    opcoesDP.memoriaMaximaBytes = static_cast<std::size_t>(requisicao.memoriaDPMB * 1024.0 * 1024.0);
+
+    // O prazo conta a partir daqui, sem o tempo na fila
+    std::optional<Interrupcao> prazo;
+    if (requisicao.prazoMs > 0.0) {
+        prazo.emplace(Interrupcao::Relogio::now() +
+                      std::chrono::microseconds(static_cast<long long>(requisicao.prazoMs * 1000.0)));
+        requisicao.params.interrupcao = &*prazo;
+    }
+
+    OrienteeringProblemSolver& solver = *catalogo->second;
+    ResultadoSolucao resultado;
+    DecisaoDespacho decisao;
+    try {
+        if (algoritmo == Algoritmo::Automatico) {
+            // O prazo da consulta também é a latência que o despacho mira
+            SLAConsulta sla;
+            sla.qualidade = qualidade;
+            sla.opcoesDP = opcoesDP;
+            if (requisicao.prazoMs > 0.0) sla.latenciaMaximaMs = static_cast<long>(std::ceil(requisicao.prazoMs));
+            resultado = solver.resolver(requisicao.params, sla, &decisao);
+        } else {
+            resultado = solver.resolver(algoritmo, requisicao.params, opcoesDP);
+        }
+    } catch (const std::exception& e) {
+        return respostaErro(requisicao.id, e.what());
+    }
+
+    std::string resposta = "{\"id\":" + requisicao.id;
+    resposta += resultado.solucaoValida ? ",\"valida\":true" : ",\"valida\":false";
+    resposta += ",\"pontuacao\":" + std::to_string(resultado.pontuacaoTotal);
+    resposta += ",\"distanciaKm\":";
+    anexarDecimal(resposta, resultado.custoKm);
+    resposta += ",\"tempoHoras\":";
+    anexarDecimal(resposta, resultado.tempoHoras);
+    resposta += resultado.otimoComprovado ? ",\"otimo\":true" : ",\"otimo\":false";
+    resposta += resultado.interrompida ? ",\"interrompida\":true" : ",\"interrompida\":false";
+    if (algoritmo == Algoritmo::Automatico) {
+        resposta += ",\"algoritmo\":\"";
+        resposta += nomeAlgoritmo(decisao.algoritmo);
+        resposta += "\",\"estimadoMs\":";
+        anexarDecimal(resposta, decisao.tempoEstimadoMs);
+        resposta += ",\"estadosEstimados\":";
+        anexarDecimal(resposta, decisao.estadosEstimados);
+        resposta += decisao.metaAtendida ? ",\"metaAtendida\":true" : ",\"metaAtendida\":false";
+    }
+    resposta += ",\"rota\":[";
+    for (std::size_t i = 0; i < resultado.rota.size(); ++i) {
+        if (i) resposta += ',';
+        resposta += std::to_string(solver.obterLocal(resultado.rota[i]).id);
+    }
+    resposta += "],\"tempoMs\":" + std::to_string(resultado.tempoExecucaoMs);
+    if (requisicao.metricas) {
+        resposta += ",\"metricas\":" + metricasJson(resultado.metricas);
+    }
+    resposta += '}';
+    return resposta;
+}
+
+void ServidorSolver::executarWorker() {
+    // A DP só é pedida por algumas consultas: a tabela fica para a primeira delas
+    for (const auto& [nome, solver] : catalogos) {
+        solver->prepararEspacoTrabalho();
+    }
+
+    while (true) {
+        Tarefa tarefa;
+        {
+            std::unique_lock<std::mutex> trava(mutexFila);
+            condicaoFila.wait(trava, [&] { return encerrando || !fila.empty(); });
+            if (fila.empty()) return;  // Encerrando e sem nada pendente
+
+            tarefa = std::move(fila.front());
+            fila.pop_front();
+        }
+        condicaoFila.notify_all();  // Pode haver leitor esperando espaço
+
+        // Conexão já derrubada: a resposta seria descartada
+        if (!tarefa.conexao->ativa()) {
+            tarefa.conexao->concluir({});
+            continue;
+        }
+
+        std::string resposta = responder(tarefa.requisicao);
+        resposta += '\n';
+        tarefa.conexao->concluir(resposta);
+    }
+}
+
+void ServidorSolver::atenderConexao(std::shared_ptr<Conexao> conexao) {
+    using Relogio = std::chrono::steady_clock;
+    std::string pendente;
+    char bloco[16 * 1024];
+    bool lendo = true;
+    Relogio::time_point ultimoEnvio = Relogio::now();
+
+    while (true) {
+        bool querLer, querEscrever;
+        {
+            std::lock_guard<std::mutex> trava(conexao->mutexSaida);
+            if (!conexao->aberta) break;
+            if (leituraEncerrada.load()) lendo = false;
+            querEscrever = !conexao->saida.empty();
+            if (!lendo && !querEscrever && conexao->pendentes == 0) break;  // Tudo respondido
+            querLer = lendo && !querEscrever && conexao->pendentes < PENDENTES_MAXIMOS_CONEXAO;
+        }
+        if (!querEscrever) ultimoEnvio = Relogio::now();
+
+        pollfd espera[2] = {
+            {conexao->fd, static_cast<short>((querLer ? POLLIN : 0) | (querEscrever ? POLLOUT : 0)), 0},
+            {conexao->evento, POLLIN, 0},
+        };
+        if (poll(espera, 2, INTERVALO_POLL_MS) < 0 && errno != EINTR) break;
+
+        if (espera[1].revents & POLLIN) {
+            uint64_t contador;
+            (void)read(conexao->evento, &contador, sizeof(contador));
+        }
+
+        if (querEscrever) {
+            bool progrediu = false;
+            if ((espera[0].revents & (POLLOUT | POLLERR | POLLHUP)) && !conexao->descarregar(progrediu)) break;
+            if (progrediu) {
+                ultimoEnvio = Relogio::now();
+            } else if (Relogio::now() - ultimoEnvio > TEMPO_MAXIMO_SEM_ENVIO) {
+                conexao->fechar();
+                break;
+            }
+        }
+
+        if (!querLer || !(espera[0].revents & (POLLIN | POLLERR | POLLHUP))) continue;
+
+        const ssize_t lidos = recv(conexao->fd, bloco, sizeof(bloco), MSG_DONTWAIT);
+        if (lidos < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) continue;
+        if (lidos <= 0) {
+            lendo = false;  // Respostas pendentes ainda são escritas; o cliente pode ter só fechado a escrita
+            continue;
+        }
+
+        pendente.append(bloco, static_cast<std::size_t>(lidos));
+
+        // Enfileira cada linha completa
+        std::size_t inicio = 0;
+        for (std::size_t fim; (fim = pendente.find('\n', inicio)) != std::string::npos; inicio = fim + 1) {
+            std::size_t tamanho = fim - inicio;
+            if (tamanho > 0 && pendente[fim - 1] == '\r') --tamanho;
+            if (tamanho == 0) continue;
+
+            conexao->reservar();
+            std::unique_lock<std::mutex> trava(mutexFila);
+            condicaoFila.wait(trava, [&] { return encerrando || fila.size() < TAMANHO_MAXIMO_FILA; });
+            fila.push_back({conexao, pendente.substr(inicio, tamanho)});
+            trava.unlock();
+            condicaoFila.notify_all();
+        }
+        pendente.erase(0, inicio);
+
+        if (pendente.size() > TAMANHO_MAXIMO_LINHA) {
+            conexao->enviar(respostaErro("null", "Linha maior que o limite de " +
+                                         std::to_string(TAMANHO_MAXIMO_LINHA) + " bytes") + "\n");
+            lendo = false;
+            pendente.clear();
+        }
+    }
+
+    shutdown(conexao->fd, SHUT_RDWR);
+}
+
+int ServidorSolver::executar(const std::string& endereco) {
+    if (catalogos.empty()) {
+        throw std::runtime_error("Servidor sem catalogos carregados");
+    }
+
+    const int fdEscuta = abrirSocketEscuta(endereco);
+    const bool tcp = enderecoTcp(endereco);
+
+    // Sem SA_RESTART: o poll acorda com EINTR e o laço vê o pedido
+    struct sigaction acao{};
+    acao.sa_handler = tratarSinal;
+    sigemptyset(&acao.sa_mask);
+    sigaction(SIGINT, &acao, nullptr);
+    sigaction(SIGTERM, &acao, nullptr);
+
+    {
+        std::lock_guard<std::mutex> trava(mutexFila);
+        encerrando = false;
+    }
+    leituraEncerrada.store(false);
+    for (int i = 0; i < numWorkers; ++i) {
+        workers.emplace_back([this] { executarWorker(); });
+    }
+
+    std::cerr << "Servidor ouvindo em " << (tcp ? "127.0.0.1:" : "") << endereco
+              << " (" << numWorkers << " workers, catalogos:";
+    for (const auto& catalogo : catalogos) {
+        std::cerr << " " << catalogo.first;
+    }
+    std::cerr << ")\n";
+
+    while (!sinalEncerrar.load()) {
+        pollfd espera{fdEscuta, POLLIN, 0};
+        if (poll(&espera, 1, INTERVALO_POLL_MS) <= 0) continue;
+
+        const int fd = accept4(fdEscuta, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) continue;
+        if (tcp) desativarNagle(fd);
+
+        auto conexao = std::make_shared<Conexao>(fd);
+        {
+            std::lock_guard<std::mutex> trava(mutexConexoes);
+            conexoes.remove_if([](const std::weak_ptr<Conexao>& antiga) { return antiga.expired(); });
+            conexoes.push_back(conexao);
+            ++leitoresAtivos;
+        }
+
+        std::thread([this, conexao = std::move(conexao)]() mutable {
+            atenderConexao(std::move(conexao));
+
+            // Notifica com a trava: depois dela a thread não toca mais no servidor
+            std::lock_guard<std::mutex> trava(mutexConexoes);
+            --leitoresAtivos;
+            condicaoLeitores.notify_all();
+        }).detach();
+    }
+
+    std::cerr << "Encerrando servidor...\n";
+    close(fdEscuta);
+    if (!tcp) unlink(endereco.c_str());
+
+    encerrar();
+    return 0;
+}
+
+void ServidorSolver::encerrar() {
+    // Leitores param de ler; as respostas já enfileiradas ainda saem, e quem
+    // não as lê é desconectado depois de TEMPO_MAXIMO_SEM_ENVIO
+    leituraEncerrada.store(true);
+    {
+        std::unique_lock<std::mutex> trava(mutexConexoes);
+        for (const auto& referencia : conexoes) {
+            if (auto conexao = referencia.lock()) conexao->acordar();
+        }
+        condicaoLeitores.wait(trava, [&] { return leitoresAtivos == 0; });
+    }
+
+    // Workers esvaziam a fila antes de sair
+    {
+        std::lock_guard<std::mutex> trava(mutexFila);
+        encerrando = true;
+    }
+    condicaoFila.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    conexoes.clear();
+}
+
+// CLIENTE DE TESTE
+
+namespace {
+    // Número do "id" no início de uma resposta do servidor; -1 se não houver
+    long idDaResposta(std::string_view resposta) {
+        constexpr std::string_view prefixo = "{\"id\":";
+        if (resposta.substr(0, prefixo.size()) != prefixo) return -1;
+        long id = -1;
+        const char* inicio = resposta.data() + prefixo.size();
+        const auto [fim, erro] = std::from_chars(inicio, resposta.data() + resposta.size(), id);
+        return (erro == std::errc() && fim != inicio) ? id : -1;
+    }
+}
+
+int executarClienteServidor(const std::string& endereco, const std::string& arquivoConsultas,
+                            const std::string& algoritmo, int emVoo) {
+    std::ifstream arquivo(arquivoConsultas);
+    if (!arquivo.is_open()) {
+        throw std::runtime_error("Impossivel abrir o arquivo: " + arquivoConsultas);
+    }
+
+    // O cliente só lê depois de completar a janela: com janelas grandes, as
+    // respostas encheriam o socket, o servidor pararia de ler e os dois
+    // travariam no envio
+    emVoo = std::clamp(emVoo, 1, EM_VOO_MAXIMO_CLIENTE);
+
+    // As requisições são montadas antes: o laço de envio só mede o servidor
+    std::vector<std::pair<long, std::string>> requisicoes;  // "id" e linha JSON
+    std::string linha;
+    std::getline(arquivo, linha);  // Cabeçalho
+
+    int linhaAtual = 1;
+    while (std::getline(arquivo, linha)) {
+        ++linhaAtual;
+        if (linha.empty()) continue;
+
+        std::stringstream ss(linha);
+        ParametrosViagem params;
+        char separador;
+        if (!(ss >> params.latitudePartida >> separador >> params.longitudePartida >> separador
+                 >> params.orcamentoHoras >> separador >> params.velocidadeKmh)) {
+            std::cerr << "Aviso: Consulta invalida na linha " << linhaAtual << ", ignorando.\n";
+            continue;
+        }
+
+        const long id = linhaAtual - 1;
+        char requisicao[256];
+        std::snprintf(requisicao, sizeof(requisicao),
+                      "{\"id\":%ld,\"latitude\":%.17g,\"longitude\":%.17g,\"orcamentoHoras\":%.17g,"
+                      "\"velocidadeKmh\":%.17g,\"algoritmo\":\"%s\"}\n",
+                      id, params.latitudePartida, params.longitudePartida,
+                      params.orcamentoHoras, params.velocidadeKmh, algoritmo.c_str());
+        requisicoes.emplace_back(id, requisicao);
+    }
+
+    const int fd = conectar(endereco);
+
+    // Instante de envio por "id"; zerado enquanto a consulta não saiu
+    std::vector<std::chrono::steady_clock::time_point> envios(static_cast<std::size_t>(linhaAtual));
+    std::vector<double> latencias;
+    latencias.reserve(requisicoes.size());
+    std::string recebido;
+    std::size_t enviadas = 0;
+
+    const auto inicioTotal = std::chrono::steady_clock::now();
+    while (latencias.size() < requisicoes.size()) {
+        // Completa a janela: até emVoo consultas sem resposta
+        while (enviadas < requisicoes.size() && enviadas - latencias.size() < static_cast<std::size_t>(emVoo)) {
+            const auto& [id, requisicao] = requisicoes[enviadas];
+            envios[id] = std::chrono::steady_clock::now();
+            if (!enviarTudo(fd, requisicao.data(), requisicao.size())) {
+                close(fd);
+                throw erroSistema("send");
+            }
+            ++enviadas;
+        }
+
+        std::size_t fimLinha;
+        while ((fimLinha = recebido.find('\n')) == std::string::npos) {
+            char bloco[4096];
+            const ssize_t lidos = recv(fd, bloco, sizeof(bloco), 0);
+            if (lidos < 0 && errno == EINTR) continue;
+            if (lidos <= 0) {
+                close(fd);
+                throw std::runtime_error("Servidor fechou a conexao");
+            }
+            recebido.append(bloco, static_cast<std::size_t>(lidos));
+        }
+        const auto fim = std::chrono::steady_clock::now();
+
+        // Com mais de uma em voo, as respostas chegam na ordem em que ficam prontas
+        const std::string_view resposta(recebido.data(), fimLinha);
+        const long id = idDaResposta(resposta);
+        if (id < 0 || static_cast<std::size_t>(id) >= envios.size() ||
+            envios[id] == std::chrono::steady_clock::time_point{}) {
+            close(fd);
+            throw std::runtime_error("Resposta sem id conhecido: " + std::string(resposta));
+        }
+
+        latencias.push_back(std::chrono::duration<double, std::micro>(fim - envios[id]).count());
+        std::cout << resposta << "\n";
+        recebido.erase(0, fimLinha + 1);
+    }
+    const double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicioTotal).count();
+    close(fd);
+
+    if (!latencias.empty()) {
+        std::sort(latencias.begin(), latencias.end());
+        auto percentil = [&](double p) {
+            return latencias[static_cast<std::size_t>(p * static_cast<double>(latencias.size() - 1))];
+        };
+        std::fprintf(stderr, "%zu consultas, %d em voo: p50 %.1f us, p99 %.1f us, max %.1f us, %.0f consultas/s\n",
+                     latencias.size(), emVoo, percentil(0.50), percentil(0.99), latencias.back(),
+                     static_cast<double>(latencias.size()) / segundos);
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include "Solver.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// SERVIDOR DE CONSULTAS (SOCKET LOCAL)
+//
+// Mantém os catálogos carregados e responde consultas por um socket Unix
+// ou TCP em 127.0.0.1. O protocolo é JSON delimitado por linha: cada linha
+// é um objeto plano e recebe exatamente uma linha de resposta.
+//
+//   {"id":1,"latitude":-22.95,"longitude":-43.2,"orcamentoHoras":3,"velocidadeKmh":30,
+//    "algoritmo":"guloso","horaPartida":8,"memoriaDPMB":64,"prazoMs":50,"catalogo":"dados_rio"}
+//   {"id":1,"valida":true,"pontuacao":412,"distanciaKm":61.204,"tempoHoras":2.040,
+//    "otimo":false,"interrompida":false,"rota":[3,7,12],"tempoMs":0}
+//
+// Só latitude, longitude, orcamentoHoras e velocidadeKmh são obrigatórios;
+// "id" é devolvido como veio. Com "prazoMs", o solver para ao fim do prazo
+// (contado do início do atendimento) e devolve a melhor rota que já tinha,
+// com "interrompida":true. Com "algoritmo":"auto", o despacho híbrido
+// escolhe o solver pela "qualidade" (rapida, refinada ou otima; padrão
+// otima) dentro de "prazoMs", e a resposta diz qual rodou em "algoritmo",
+// com "estimadoMs", "estadosEstimados" e "metaAtendida" (false quando
+// nenhum solver da qualidade pedida cabia no prazo) da decisão. A linha de
+// registro de cada despacho sai em stderr.
+// Com "metricas":true, a resposta traz "metricas":{...} com os tempos por
+// fase e os contadores do solver (veja Metricas.h).
+// Cada conexão tem uma thread leitora que enfileira as linhas num pool de
+// workers, então um cliente pode mandar várias consultas sem esperar. As
+// respostas saem na ordem em que ficam prontas e são casadas pelo "id".
+// Os workers não bloqueiam no envio: com respostas acumuladas ou 1024
+// consultas sem resposta, a conexão deixa de ser lida, e um cliente que
+// passa 5 s sem ler nada é desconectado (as respostas dele são descartadas).
+// Erros viram {"id":...,"erro":"..."}, inclusive números não finitos,
+// memoriaDPMB acima de 1 TiB e prazoMs acima de um dia.
+
+class ServidorSolver {
+	public:
+	    explicit ServidorSolver(int numWorkers = 0);
+	    ~ServidorSolver();
+
+	    ServidorSolver(const ServidorSolver&) = delete;
+	    ServidorSolver& operator=(const ServidorSolver&) = delete;
+
+	    // O primeiro catálogo é o padrão das consultas sem "catalogo"
+	    void adicionarCatalogo(const std::string& nome, std::unique_ptr<OrienteeringProblemSolver> solver);
+
+	    // Atende até SIGINT/SIGTERM. endereco: porta TCP (só números) ou
+	    // caminho do socket Unix
+	    int executar(const std::string& endereco);
+
+	    // Resposta (sem '\n') de uma linha de requisição
+	    std::string responder(std::string_view requisicao) const;
+
+	private:
+	    struct Conexao;
+
+	    struct Tarefa {
+	        std::shared_ptr<Conexao> conexao;
+	        std::string requisicao;
+	    };
+
+	    std::map<std::string, std::unique_ptr<OrienteeringProblemSolver>, std::less<>> catalogos;
+	    std::string catalogoPadrao;
+
+	    const int numWorkers;
+	    std::vector<std::thread> workers;
+	    std::deque<Tarefa> fila;
+	    std::mutex mutexFila;
+	    std::condition_variable condicaoFila;
+	    bool encerrando = false;
+
+	    // Leitores rodam destacados; encerrar() espera o contador zerar
+	    std::atomic<bool> leituraEncerrada{false};
+	    std::list<std::weak_ptr<Conexao>> conexoes;
+	    int leitoresAtivos = 0;
+	    std::mutex mutexConexoes;
+	    std::condition_variable condicaoLeitores;
+
+	    void executarWorker();
+	    void atenderConexao(std::shared_ptr<Conexao> conexao);
+	    void encerrar();
+};
+
+// Cliente de teste: envia as consultas do CSV (formato do modo lote) com
+// até emVoo delas (no máximo 256) aguardando resposta ao mesmo tempo
+// (1 = uma a uma), escreve as respostas na saída padrão e, em stderr, a
+// latência p50/p99 de cada consulta (do envio à resposta) e a vazão
+int executarClienteServidor(const std::string& endereco, const std::string& arquivoConsultas,
+                            const std::string& algoritmo, int emVoo = 1);
+
+#endif // SERVIDOR_H
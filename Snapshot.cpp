@@ -0,0 +1,253 @@
+#include "Solver.h"
+#include "ArquivoMapeado.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// SNAPSHOT BINÁRIO DO GRAFO (MAPEADO EM MEMÓRIA)
+//
+// Layout (inteiros e doubles no formato nativo, seções alinhadas em 64 bytes):
+//   CabecalhoSnapshot
+//   RegistroLocal[n]                 id, pontuação, coordenadas, horário, nome
+//   char[tamanhoNomes]               nomes concatenados
+//   double x[n], y[n], z[n]          vetores unitários do kernel de distâncias
+//   double[n · n]                    matriz densa, ou
+//   int32[n · k] + double[n · k]     vizinhos k-NN e suas distâncias
+// A carga mapeia o arquivo somente leitura e o grafo lê a matriz direto do
+// mapeamento: processos que abrem o mesmo snapshot compartilham as páginas.
+// Por isso a gravação nunca reescreve o arquivo no lugar (truncar um arquivo
+// mapeado dá SIGBUS em quem o lê): grava <arquivo>.tmp, faz fsync e troca
+// com rename(), e quem já mapeou continua com a versão antiga.
+
+namespace {
+    constexpr char MAGICA[8] = {'O', 'P', 'G', 'R', 'A', 'F', 'O', '\0'};
+    constexpr uint32_t VERSAO_SNAPSHOT = 2;
+    constexpr uint32_t MARCA_ENDIANNESS = 0x01020304;
+    constexpr uint64_t ALINHAMENTO = 64;
+    
+    struct CabecalhoSnapshot {
+        char magica[8];
+        uint32_t versao;
+        uint32_t marcaEndianness;
+        uint64_t numLocais;
+        uint64_t vizinhosPorLocal;  // 0 = grafo denso
+        uint64_t offsetLocais;
+        uint64_t offsetNomes;
+        uint64_t tamanhoNomes;
+        uint64_t offsetCoordenadas;
+        uint64_t offsetVizinhos;
+        uint64_t offsetDistancias;
+        uint64_t tamanhoArquivo;
+    };
+    
+    struct RegistroLocal {
+        int32_t id;
+        int32_t pontuacao;
+        double latitude;
+        double longitude;
+        double duracaoVisitaHoras;
+        double aberturaHoras;
+        double fechamentoHoras;
+        uint64_t offsetNome;
+        uint64_t tamanhoNome;
+    };
+    
+    uint64_t alinhar(uint64_t offset) {
+        return (offset + ALINHAMENTO - 1) / ALINHAMENTO * ALINHAMENTO;
+    }
+    
+    void escreverPreenchimento(std::ofstream& arquivo, uint64_t ate) {
+        static const char zeros[ALINHAMENTO] = {};
+        const uint64_t atual = static_cast<uint64_t>(arquivo.tellp());
+        arquivo.write(zeros, static_cast<std::streamsize>(ate - atual));
+    }
+    
+    template <typename T>
+    void escreverArray(std::ofstream& arquivo, const T* dados, uint64_t quantidade) {
+        arquivo.write(reinterpret_cast<const char*>(dados), static_cast<std::streamsize>(quantidade * sizeof(T)));
+    }
+    
+    // Garante no disco o conteúdo de um arquivo (ou de um diretório) já gravado
+    bool sincronizar(const std::string& caminho) {
+        const int descritor = ::open(caminho.c_str(), O_RDONLY);
+        if (descritor < 0) return false;
+        const bool ok = ::fsync(descritor) == 0;
+        ::close(descritor);
+        return ok;
+    }
+    
+    // [offset, offset + tamanho) dentro de [0, limite), sem estourar uint64
+    bool secaoDentro(uint64_t offset, uint64_t tamanho, uint64_t limite) {
+        return offset <= limite && tamanho <= limite - offset;
+    }
+}
+
+void OrienteeringProblemSolver::salvarSnapshot(const std::string& arquivoSnapshot) const {
+    validarDados();
+    
+    const GrafoDistancias::Visao grafoAtual = grafo.visao();
+    if (grafoAtual.numLocais != static_cast<int>(locais.size())) {
+        throw std::runtime_error("Grafo nao construido; chame construirGrafo antes de salvar o snapshot");
+    }
+    
+    const uint64_t n = locais.size();
+    const uint64_t k = static_cast<uint64_t>(grafoAtual.vizinhosPorLocal);
+    
+    std::string nomes;
+    std::vector<RegistroLocal> registros(n);
+    for (uint64_t i = 0; i < n; ++i) {
+        registros[i] = {locais[i].id, locais[i].pontuacao, locais[i].latitude, locais[i].longitude,
+                        locais[i].duracaoVisitaHoras, locais[i].aberturaHoras, locais[i].fechamentoHoras,
+                        nomes.size(), nomesPorLocal[i].size()};
+        nomes += nomesPorLocal[i];
+    }
+    
+    CabecalhoSnapshot cabecalho{};
+    std::memcpy(cabecalho.magica, MAGICA, sizeof(MAGICA));
+    cabecalho.versao = VERSAO_SNAPSHOT;
+    cabecalho.marcaEndianness = MARCA_ENDIANNESS;
+    cabecalho.numLocais = n;
+    cabecalho.vizinhosPorLocal = k;
+    cabecalho.offsetLocais = alinhar(sizeof(CabecalhoSnapshot));
+    cabecalho.offsetNomes = alinhar(cabecalho.offsetLocais + n * sizeof(RegistroLocal));
+    cabecalho.tamanhoNomes = nomes.size();
+    cabecalho.offsetCoordenadas = alinhar(cabecalho.offsetNomes + nomes.size());
+    cabecalho.offsetVizinhos = alinhar(cabecalho.offsetCoordenadas + 3 * n * sizeof(double));
+    cabecalho.offsetDistancias = alinhar(cabecalho.offsetVizinhos + n * k * sizeof(int32_t));
+    const uint64_t numDistancias = (k == 0) ? n * n : n * k;
+    cabecalho.tamanhoArquivo = cabecalho.offsetDistancias + numDistancias * sizeof(double);
+    
+    const std::string arquivoTemporario = arquivoSnapshot + ".tmp";
+    std::ofstream arquivo(arquivoTemporario, std::ios::binary | std::ios::trunc);
+    if (!arquivo.is_open()) {
+        throw std::runtime_error("Impossivel criar o arquivo: " + arquivoTemporario);
+    }
+    
+    arquivo.write(reinterpret_cast<const char*>(&cabecalho), sizeof(cabecalho));
+    escreverPreenchimento(arquivo, cabecalho.offsetLocais);
+    escreverArray(arquivo, registros.data(), n);
+    escreverPreenchimento(arquivo, cabecalho.offsetNomes);
+    arquivo.write(nomes.data(), static_cast<std::streamsize>(nomes.size()));
+    escreverPreenchimento(arquivo, cabecalho.offsetCoordenadas);
+    escreverArray(arquivo, grafoAtual.x, n);
+    escreverArray(arquivo, grafoAtual.y, n);
+    escreverArray(arquivo, grafoAtual.z, n);
+    escreverPreenchimento(arquivo, cabecalho.offsetVizinhos);
+    if (k > 0) {
+        static_assert(sizeof(int) == sizeof(int32_t), "vizinhos gravados como int32");
+        escreverArray(arquivo, grafoAtual.vizinhos, n * k);
+    }
+    escreverPreenchimento(arquivo, cabecalho.offsetDistancias);
+    escreverArray(arquivo, (k == 0) ? grafoAtual.matriz : grafoAtual.distanciasVizinhos, numDistancias);
+    arquivo.close();
+    
+    if (!arquivo || !sincronizar(arquivoTemporario) ||
+        std::rename(arquivoTemporario.c_str(), arquivoSnapshot.c_str()) != 0) {
+        std::remove(arquivoTemporario.c_str());
+        throw std::runtime_error("Falha ao gravar o snapshot: " + arquivoSnapshot);
+    }
+    
+    // A troca de nome só é durável depois do fsync do diretório
+    const std::size_t barra = arquivoSnapshot.find_last_of('/');
+    sincronizar(barra == std::string::npos ? "." : arquivoSnapshot.substr(0, barra + 1));
+    
+    saida() << "Snapshot gravado: " << n << " locais, " << cabecalho.tamanhoArquivo << " bytes.\n";
+}
+
+void OrienteeringProblemSolver::carregarSnapshot(const std::string& arquivoSnapshot) {
+    auto mapeamento = std::make_shared<const ArquivoMapeado>(arquivoSnapshot);
+    const char* base = mapeamento->dados;
+    
+    auto invalido = [&](const std::string& motivo) {
+        return std::runtime_error("Snapshot invalido (" + motivo + "): " + arquivoSnapshot);
+    };
+    
+    if (mapeamento->tamanho < sizeof(CabecalhoSnapshot)) throw invalido("arquivo truncado");
+    
+    CabecalhoSnapshot cabecalho;
+    std::memcpy(&cabecalho, base, sizeof(cabecalho));
+    
+    if (std::memcmp(cabecalho.magica, MAGICA, sizeof(MAGICA)) != 0) throw invalido("assinatura");
+    if (cabecalho.marcaEndianness != MARCA_ENDIANNESS) throw invalido("endianness");
+    if (cabecalho.versao != VERSAO_SNAPSHOT) {
+        throw invalido("versao " + std::to_string(cabecalho.versao) + ", esperada " +
+                       std::to_string(VERSAO_SNAPSHOT));
+    }
+    
+    const uint64_t n = cabecalho.numLocais;
+    const uint64_t k = cabecalho.vizinhosPorLocal;
+    const uint64_t numDistancias = (k == 0) ? n * n : n * k;
+    const uint64_t tamanho = mapeamento->tamanho;
+    
+    // Dimensões limitadas pelo próprio arquivo antes de qualquer multiplicação
+    if (n == 0 || n > static_cast<uint64_t>(std::numeric_limits<int>::max()) || k >= n + (n == 1) ||
+        numDistancias > tamanho / sizeof(double) || n > tamanho / sizeof(RegistroLocal)) {
+        throw invalido("dimensoes");
+    }
+    if (cabecalho.tamanhoArquivo != tamanho ||
+        !secaoDentro(cabecalho.offsetLocais, n * sizeof(RegistroLocal), cabecalho.offsetNomes) ||
+        !secaoDentro(cabecalho.offsetNomes, cabecalho.tamanhoNomes, cabecalho.offsetCoordenadas) ||
+        !secaoDentro(cabecalho.offsetCoordenadas, 3 * n * sizeof(double), cabecalho.offsetVizinhos) ||
+        !secaoDentro(cabecalho.offsetVizinhos, n * k * sizeof(int32_t), cabecalho.offsetDistancias) ||
+        !secaoDentro(cabecalho.offsetDistancias, numDistancias * sizeof(double), tamanho)) {
+        throw invalido("secoes fora do arquivo");
+    }
+    if (cabecalho.offsetLocais % alignof(RegistroLocal) || cabecalho.offsetCoordenadas % alignof(double) ||
+        cabecalho.offsetVizinhos % alignof(int32_t) || cabecalho.offsetDistancias % alignof(double)) {
+        throw invalido("alinhamento");
+    }
+    
+    // Locais e nomes são copiados (O(n)); distâncias ficam no mapeamento.
+    // O bloco de nomes vira a arena do solver de uma vez só.
+    const auto* registros = reinterpret_cast<const RegistroLocal*>(base + cabecalho.offsetLocais);
+    std::vector<char> arena(base + cabecalho.offsetNomes, base + cabecalho.offsetNomes + cabecalho.tamanhoNomes);
+    
+    std::vector<Local> carregados(n);
+    std::vector<std::string_view> nomes(n);
+    for (uint64_t i = 0; i < n; ++i) {
+        const RegistroLocal& registro = registros[i];
+        if (!secaoDentro(registro.offsetNome, registro.tamanhoNome, cabecalho.tamanhoNomes)) throw invalido("nomes");
+        
+        carregados[i].id = registro.id;
+        nomes[i] = std::string_view(arena.data() + registro.offsetNome, registro.tamanhoNome);
+        carregados[i].latitude = registro.latitude;
+        carregados[i].longitude = registro.longitude;
+        carregados[i].pontuacao = registro.pontuacao;
+        carregados[i].duracaoVisitaHoras = registro.duracaoVisitaHoras;
+        carregados[i].aberturaHoras = registro.aberturaHoras;
+        carregados[i].fechamentoHoras = registro.fechamentoHoras;
+    }
+    
+    const auto* coordenadas = reinterpret_cast<const double*>(base + cabecalho.offsetCoordenadas);
+    
+    GrafoDistancias::Visao visao;
+    visao.numLocais = static_cast<int>(n);
+    visao.vizinhosPorLocal = static_cast<int>(k);
+    visao.x = coordenadas;
+    visao.y = coordenadas + n;
+    visao.z = coordenadas + 2 * n;
+    if (k == 0) {
+        visao.matriz = reinterpret_cast<const double*>(base + cabecalho.offsetDistancias);
+    } else {
+        visao.vizinhos = reinterpret_cast<const int*>(base + cabecalho.offsetVizinhos);
+        visao.distanciasVizinhos = reinterpret_cast<const double*>(base + cabecalho.offsetDistancias);
+    }
+    
+    locais = std::move(carregados);
+    nomesLocais = std::move(arena);  // Move de vector preserva o buffer
+    nomesPorLocal = std::move(nomes);
+    cacheOrigem->limpar();
+    atualizarModeloHorario();
+    grafo.adotar(visao, std::move(mapeamento));
+    indiceEspacial.construir(locais, RAIO_TERRA_KM);
+    
+    saida() << locais.size() << " locais carregados do snapshot ("
+            << (k == 0 ? "grafo denso" : "grafo esparso") << ").\n";
+}
@@ -1,21 +1,46 @@
 #ifndef SOLVER_H
 #define SOLVER_H
 
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <limits>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <optional>
 #include <memory>
+#include "CacheOrigem.h"
+#include "GrafoDistancias.h"
+#include "IndiceEspacial.h"
+#include "Interrupcao.h"
+#include "Metricas.h"
+#include "PerfilVelocidade.h"
 
 // ESTRUTURAS DE DADOS
 
 struct Local {
-    int id;
-    std::string nome;
+    int id;  // O nome fica no solver: OrienteeringProblemSolver::nomeLocal
     double latitude;
     double longitude;
     int pontuacao;
     
-    Local() : id(0), latitude(0.0), longitude(0.0), pontuacao(0) {}
+    // Visita e horário de funcionamento (horas desde 0h do dia do passeio).
+    // A visita começa na chegada ou na abertura e precisa terminar até o
+    // fechamento; sem janela, abertura = -inf e fechamento = +inf.
+    double duracaoVisitaHoras;
+    double aberturaHoras;
+    double fechamentoHoras;
+    
+    Local() : id(0), latitude(0.0), longitude(0.0), pontuacao(0), duracaoVisitaHoras(0.0),
+              aberturaHoras(-std::numeric_limits<double>::infinity()),
+              fechamentoHoras(std::numeric_limits<double>::infinity()) {}
+    
+    bool possuiRestricaoHorario() const {
+        return duracaoVisitaHoras > 0.0 || aberturaHoras > -std::numeric_limits<double>::infinity() ||
+               fechamentoHoras < std::numeric_limits<double>::infinity();
+    }
 };
 
 struct ParametrosViagem {
@@ -23,6 +48,8 @@ struct ParametrosViagem {
     double longitudePartida;
     double orcamentoHoras;
     double velocidadeKmh;
+    double horaPartida = 0.0;  // Horas desde 0h; só importa no modo horário
+    const Interrupcao* interrupcao = nullptr;  // Prazo/cancelamento opcional (ver Interrupcao.h)
     
     bool validar() const {
         return velocidadeKmh > 0.0 && orcamentoHoras > 0.0;
@@ -40,8 +67,114 @@ struct ResultadoSolucao {
     std::vector<int> rota;  // Índices dos locais visitados
     long tempoExecucaoMs;
     bool solucaoValida;
+    bool otimoComprovado;   // Solver exato que não precisou descartar estados
+    bool interrompida;      // Parou por prazo/cancelamento; rota é a melhor até então
+    MetricasSolucao metricas;
+    
+    ResultadoSolucao() : pontuacaoTotal(0), custoKm(0.0), tempoHoras(0.0), tempoExecucaoMs(0),
+                         solucaoValida(false), otimoComprovado(false), interrompida(false) {}
+};
+
+struct OpcoesDP {
+    bool precisaoSimples;  // Custos da tabela em float (menos memória)
+    int numThreads;        // Threads nas transições (0 = todos os núcleos)
+    bool usarSimd;         // Kernel AVX2/AVX-512 quando a CPU suportar
+    
+    // Teto de memória da DP (0 = sem limite). Se a tabela completa não
+    // couber, ou se houver mais de MAX_LOCAIS_DP locais, a DP vira uma busca
+    // em feixe que guarda os melhores estados de cada camada dentro do teto.
+    std::size_t memoriaMaximaBytes;
     
-    ResultadoSolucao() : pontuacaoTotal(0), custoKm(0.0), tempoHoras(0.0), tempoExecucaoMs(0), solucaoValida(false) {}
+    // Maior tabela que a thread guarda para a próxima DP (EspacoTrabalho.h).
+    // Acima disso, ou do teto de memória, a tabela é liberada ao fim da
+    // consulta. O padrão cobre a DP de 20 locais em double (~190 MB).
+    std::size_t retencaoTabelaBytes;
+    
+    OpcoesDP() : precisaoSimples(false), numThreads(1), usarSimd(true), memoriaMaximaBytes(0),
+                 retencaoTabelaBytes(std::size_t(256) * 1024 * 1024) {}
+    
+    // Retenção efetiva: nunca acima do teto da consulta
+    std::size_t limiteRetencao() const {
+        return (memoriaMaximaBytes > 0 && memoriaMaximaBytes < retencaoTabelaBytes) ? memoriaMaximaBytes
+                                                                                   : retencaoTabelaBytes;
+    }
+};
+
+// Ponto da fronteira custo x pontuação: melhor pontuação possível com
+// custo de fechamento (ida + volta a S) até custoKm
+struct PontoPareto {
+    double custoKm;
+    int pontuacao;
+    std::vector<int> rota;
+};
+
+// Fronteira de Pareto de uma origem, ordenada por custo crescente (e
+// pontuação estritamente crescente). Responde qualquer orçamento.
+struct FronteiraPareto {
+    double latitudePartida;
+    double longitudePartida;
+    std::vector<PontoPareto> pontos;
+    
+    FronteiraPareto() : latitudePartida(0.0), longitudePartida(0.0) {}
+};
+
+struct OpcoesGRASP {
+    int numThreads;          // Threads de busca (0 = todos os núcleos)
+    int maxIteracoes;        // Construções + busca local, somadas entre as threads
+    long tempoLimiteMs;      // Orçamento de tempo (0 = sem limite)
+    int perturbacoesILS;     // Rodadas de perturbação por construção
+    double alfa;             // Tamanho da lista restrita de candidatos (0 = guloso puro)
+    unsigned int semente;    // Semente base; cada thread deriva a sua
+    
+    OpcoesGRASP() : numThreads(0), maxIteracoes(256), tempoLimiteMs(1000),
+                    perturbacoesILS(8), alfa(0.3), semente(2024) {}
+};
+
+enum class Algoritmo {
+    Guloso,
+    GulosoBuscaLocal,
+    ProgramacaoDinamica,
+    ProgramacaoDinamicaEsparsa,
+    BranchAndBound,
+    GRASP,
+    Automatico  // Despacho por SLAConsulta (ver resolver(params, sla))
+};
+
+// Nome usado no modo lote e no servidor (guloso, guloso-bl, dp, dp-esparsa, bb, grasp, auto)
+bool interpretarAlgoritmo(std::string_view nome, Algoritmo& algoritmo);
+const char* nomeAlgoritmo(Algoritmo algoritmo);
+
+// Meta de uma consulta para o despacho automático. Qualidades acima da
+// pedida também atendem: uma DP de poucos locais pode sair mais barata que
+// a busca local.
+enum class QualidadeAlvo {
+    Rapida,    // Guloso
+    Refinada,  // Guloso + busca local
+    Otima      // Solver exato (DP densa ou branch-and-bound)
+};
+
+// Nome usado no servidor (rapida, refinada, otima)
+bool interpretarQualidade(std::string_view nome, QualidadeAlvo& qualidade);
+
+struct SLAConsulta {
+    QualidadeAlvo qualidade;
+    long latenciaMaximaMs;  // 0 = sem limite; vira o prazo do solver escolhido
+    OpcoesDP opcoesDP;      // Teto de memória e threads da DP densa
+    
+    SLAConsulta() : qualidade(QualidadeAlvo::Otima), latenciaMaximaMs(1000) {}
+};
+
+// O que o despacho viu e escolheu, para calibrar os limiares
+struct DecisaoDespacho {
+    Algoritmo algoritmo;
+    int candidatos;            // Locais com ida + volta dentro do orçamento
+    double densidadePares;     // Fração dos pares de candidatos que cabem numa mesma rota
+    double estadosEstimados;   // Estados (conjunto, último) alcançáveis estimados
+    double tempoEstimadoMs;
+    bool metaAtendida;         // false: nenhum solver da qualidade pedida cabia na latência
+    
+    DecisaoDespacho() : algoritmo(Algoritmo::Guloso), candidatos(0), densidadePares(0.0),
+                        estadosEstimados(0.0), tempoEstimadoMs(0.0), metaAtendida(true) {}
 };
 
 // CLASSE PRINCIPAL
@@ -50,30 +183,153 @@ class OrienteeringProblemSolver {
 	public:
 	    OrienteeringProblemSolver() = default;
 	    
+	    // Maior instância aceita pela DP exata (tabela de 2^n · n estados)
+	    static constexpr int MAX_LOCAIS_DP = 24;
+	    
+	    // Maior instância da DP esparsa (máscara de 64 bits); o limite prático
+	    // é o número de estados alcançáveis dentro do orçamento
+	    static constexpr int MAX_LOCAIS_DP_ESPARSA = 64;
+	    
+	    // Tabela da DP densa mais os vetores auxiliares de 2^n inteiros
+	    static std::size_t memoriaNecessariaDP(int n, const OpcoesDP& opcoes);
+	    
 	    // Carregamento de dados
 	    void carregarDados(const std::string& arquivoCsv);
-	    void construirGrafo();
+	    void construirGrafo(int numThreads = 0);
+	    
+	    // Grafo esparso para catálogos grandes: guarda só os k vizinhos mais
+	    // próximos de cada local e calcula os demais pares sob demanda
+	    void construirGrafoEsparso(int vizinhosPorLocal = 16, int numThreads = 0);
+	    
+	    // Snapshot binário (locais + grafo pronto), carregado por mmap: a
+	    // matriz não é copiada e processos diferentes compartilham as páginas
+	    void salvarSnapshot(const std::string& arquivoSnapshot) const;
+	    void carregarSnapshot(const std::string& arquivoSnapshot);
+	    
+	    // Velocidade dependente do horário: velocidadeKmh da consulta vezes o
+	    // fator da faixa (e da zona) em que cada trecho é percorrido. Um perfil
+	    // vazio volta à velocidade constante.
+	    //
+	    // Com perfil, ou com locais que têm duração de visita ou janela de
+	    // funcionamento, os solvers entram no modo horário: a rota parte em
+	    // horaPartida e precisa voltar a S até horaPartida + orcamentoHoras.
+	    // Guloso, DP e a busca local do guloso seguem o modo horário. DP
+	    // esparsa, branch-and-bound, GRASP e a fronteira de Pareto só conhecem
+	    // distância / velocidade constante: no modo horário recusam a consulta
+	    // (resultado inválido ou fronteira vazia, com aviso em erros()).
+	    void definirPerfilVelocidade(const PerfilVelocidade& perfil);
 	    
 	    // Algoritmos de solução
-	    ResultadoSolucao resolverProgramacaoDinamica(const ParametrosViagem& params);
+	    ResultadoSolucao resolverProgramacaoDinamica(const ParametrosViagem& params,
+	                                                 const OpcoesDP& opcoes = OpcoesDP());
+	    ResultadoSolucao resolverProgramacaoDinamicaEsparsa(const ParametrosViagem& params);
 	    ResultadoSolucao resolverGuloso(const ParametrosViagem& params);
+	    ResultadoSolucao resolverGulosoComBuscaLocal(const ParametrosViagem& params);
+	    
+	    // Metaheurística para catálogos grandes: construções gulosas
+	    // aleatorizadas + busca local + perturbações (ILS), em paralelo. Parte
+	    // da construção gulosa pura, então devolve rota mesmo sem iterações
+	    ResultadoSolucao resolverGRASP(const ParametrosViagem& params,
+	                                   const OpcoesGRASP& opcoes = OpcoesGRASP());
+	    ResultadoSolucao resolverBranchAndBound(const ParametrosViagem& params);
+	    ResultadoSolucao resolver(Algoritmo algoritmo, const ParametrosViagem& params,
+	                              const OpcoesDP& opcoesDP = OpcoesDP());
+	    
+	    // Despacho híbrido: estima o custo de cada solver para a consulta e
+	    // roda o mais barato que atende a qualidade dentro da latência. Se
+	    // nenhum atende, fica com a melhor qualidade que cabe. A decisão vai
+	    // para o registro de despacho e, se pedido, para *decisao.
+	    ResultadoSolucao resolver(const ParametrosViagem& params, const SLAConsulta& sla,
+	                              DecisaoDespacho* decisao = nullptr);
+	    
+	    // Pós-otimização (2-opt, inserção, troca) de uma rota viável qualquer
+	    ResultadoSolucao melhorarComBuscaLocal(const ResultadoSolucao& inicial,
+	                                           const ParametrosViagem& params) const;
+	    
+	    // Varredura de orçamentos: uma única DP sem poda de orçamento por
+	    // origem; consultas posteriores são uma busca binária na fronteira
+	    FronteiraPareto construirFronteiraPareto(double latitudePartida, double longitudePartida,
+	                                             const OpcoesDP& opcoes = OpcoesDP());
+	    ResultadoSolucao consultarFronteira(const FronteiraPareto& fronteira,
+	                                        const ParametrosViagem& params) const;
+	    
+	    // Resolve várias consultas sobre o mesmo grafo, em paralelo
+	    // (numThreads = 0 usa todos os núcleos). Mensagens dos solvers são
+	    // suprimidas e os resultados seguem a ordem das consultas. Se uma
+	    // consulta lançar, as threads param e a exceção é relançada aqui.
+	    std::vector<ResultadoSolucao> resolverLote(const std::vector<ParametrosViagem>& consultas,
+	                                               Algoritmo algoritmo = Algoritmo::Guloso,
+	                                               int numThreads = 0,
+	                                               const OpcoesDP& opcoesDP = OpcoesDP());
+	    
+	    // Deixa o espaço de trabalho da thread chamadora (EspacoTrabalho.h) no
+	    // tamanho deste catálogo, para que nem a primeira consulta aloque;
+	    // comTabelaDP também aloca e toca a tabela da DP densa
+	    void prepararEspacoTrabalho(bool comTabelaDP = false, const OpcoesDP& opcoes = OpcoesDP()) const;
 	    
 	    // Utilitários
 	    void exibirLocais() const;
 	    void exibirResultado(const ResultadoSolucao& resultado, const std::string& nomeAlgoritmo) const;
 	    
 	    int quantidadeLocais() const { return static_cast<int>(locais.size()); }
+	    
+	    // false se o catálogo está no modo horário e o algoritmo o recusaria
+	    // (DP esparsa, branch-and-bound, GRASP); para quem despacha
+	    // consultas rejeitar antes de chamar o solver
+	    bool suportaAlgoritmo(Algoritmo algoritmo) const;
+	    const Local& obterLocal(int indice) const { return locais[indice]; }
+	    
+	    // Nome do local, lido da arena de nomes do solver (sem cópia). Vale
+	    // enquanto este solver existir (inclusive depois de movido) e até a
+	    // próxima carga de CSV ou snapshot; para guardar, copie em std::string.
+	    std::string_view nomeLocal(int indice) const { return nomesPorLocal[indice]; }
+	    
+	    // Suprime as mensagens de progresso e avisos dos solvers
+	    void definirSilencioso(bool valor) { silencioso = valor; }
+	    
+	    // Destino da linha de registro de cada despacho (características,
+	    // estimativa e tempo real, terminada em '\n'). Não segue o silencioso
+	    // nem a supressão do lote: é o que calibra as constantes do despacho.
+	    // Vazio (padrão) escreve em std::clog. Chamado da thread que resolveu
+	    // a consulta, então precisa ser seguro entre threads.
+	    using RegistroDespacho = std::function<void(const std::string& linha)>;
+	    void definirRegistroDespacho(RegistroDespacho registro) { registroDespacho = std::move(registro); }
 
 	private:
 	    std::vector<Local> locais;
-	    std::vector<std::vector<double>> distanciasKm;  // Matriz de distâncias
+	    std::vector<char> nomesLocais;                  // Arena com os nomes de todos os locais
+	    std::vector<std::string_view> nomesPorLocal;    // Nome de cada local, dentro da arena
+	    GrafoDistancias grafo;                          // Distâncias entre locais (densas ou k-NN)
+	    // Vetores S -> i por origem recente; fora do objeto porque o mutex
+	    // do cache não se move e o solver precisa continuar movível
+	    std::unique_ptr<CacheDistanciasOrigem> cacheOrigem = std::make_unique<CacheDistanciasOrigem>();
+	    IndiceEspacial indiceEspacial;                  // Grade de locais, para podar candidatos
+	    PerfilVelocidade perfilVelocidade;              // Vazio = velocidade constante
+	    std::vector<int> zonaLocal;                     // Zona do perfil em que cada local está
+	    bool restricoesHorario = false;                 // Algum local com visita ou janela
+	    bool silencioso = false;
+	    RegistroDespacho registroDespacho;              // Vazio = std::clog
+	    static thread_local bool saidaSuprimidaNaThread;  // Workers de resolverLote
+	    
+	    // Distâncias S -> i de todos os locais, calculadas uma vez por origem
+	    CacheDistanciasOrigem::Distancias obterDistanciasOrigem(const ParametrosViagem& params) const;
+	    
+	    // DP com teto de memória: camadas de popcount truncadas nos melhores
+	    // estados (busca em feixe); exata enquanto nenhuma camada é truncada
+	    ResultadoSolucao resolverBuscaFeixe(const ParametrosViagem& params, std::size_t memoriaMaximaBytes);
+	    
+	    // Modo horário (ver RelogioViagem.h): zonas dos locais no perfil e
+	    // presença de visitas/janelas no catálogo
+	    void atualizarModeloHorario();
+	    bool modoHorario() const { return restricoesHorario || !perfilVelocidade.vazio(); }
 	    
-	    // Cálculos geométricos
-	    static double calcularDistanciaHaversine(double lat1, double lon1, double lat2, double lon2);
+	    // Para os solvers de velocidade constante: true (com aviso) se a
+	    // consulta precisa de um modelo que eles não seguem
+	    bool recusaModoHorario(const char* solver) const;
 	    
-	    // Auxiliares para DP
-	    int calcularPontuacaoMascara(int mascara) const;
-	    double calcularDistanciaParaOrigem(int indiceLocal, const ParametrosViagem& params) const;
+	    // Mensagens (std::cout / std::cerr, ou descartadas quando silencioso)
+	    std::ostream& saida() const;
+	    std::ostream& erros() const;
 	    
 	    // Validação
 	    void validarDados() const;
@@ -0,0 +1,253 @@
+#include "Solver.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+// PROGRAMAÇÃO DINÂMICA ESPARSA - APENAS ESTADOS ALCANÇÁVEIS
+
+namespace {
+    constexpr double INFINITO = std::numeric_limits<double>::max() / 2;
+    constexpr double EPSILON = 1e-9;
+    constexpr uint8_t SEM_PREDECESSOR = 0xFF;
+
+    // Estados expandidos entre consultas à Interrupcao
+    constexpr std::size_t ESTADOS_POR_VERIFICACAO = 1 << 12;
+
+    struct EstadoEsparso {
+        uint64_t mascara;
+        double custo;
+        uint8_t ultimo;
+        uint8_t predecessor;
+    };
+
+    // Ordem da fronteira: (mascara, ultimo) e, para o mesmo estado, menor
+    // custo e depois menor predecessor, como na DP densa
+    bool precede(const EstadoEsparso& a, const EstadoEsparso& b) {
+        if (a.mascara != b.mascara) return a.mascara < b.mascara;
+        if (a.ultimo != b.ultimo) return a.ultimo < b.ultimo;
+        if (a.custo != b.custo) return a.custo < b.custo;
+        return a.predecessor < b.predecessor;
+    }
+
+    // Mantém só o primeiro (mais barato) de cada (mascara, ultimo)
+    void consolidarCamada(std::vector<EstadoEsparso>& camada) {
+        std::sort(camada.begin(), camada.end(), precede);
+        auto fim = std::unique(camada.begin(), camada.end(),
+            [](const EstadoEsparso& a, const EstadoEsparso& b) {
+                return a.mascara == b.mascara && a.ultimo == b.ultimo;
+            });
+        camada.erase(fim, camada.end());
+        camada.shrink_to_fit();
+    }
+
+    const EstadoEsparso* buscarEstado(const std::vector<EstadoEsparso>& camada,
+                                      uint64_t mascara, int ultimo)
+    {
+        EstadoEsparso chave{mascara, -INFINITO, static_cast<uint8_t>(ultimo), 0};
+        auto it = std::lower_bound(camada.begin(), camada.end(), chave, precede);
+        if (it == camada.end() || it->mascara != mascara || it->ultimo != ultimo) return nullptr;
+        return &*it;
+    }
+}
+
+ResultadoSolucao OrienteeringProblemSolver::resolverProgramacaoDinamicaEsparsa(const ParametrosViagem& params) {
+    auto inicioTempo = std::chrono::high_resolution_clock::now();
+    CronometroFases cronometro;
+
+    saida() << "\nIniciando Programacao Dinamica Esparsa (Solucao otima)...\n";
+
+    ResultadoSolucao resultado;
+
+    // Validações
+    if (!params.validar()) {
+        erros() << "Parametros de viagem invalidos.\n";
+        return resultado;
+    }
+    
+    if (recusaModoHorario("Programacao Dinamica Esparsa")) {
+        return resultado;
+    }
+
+    validarDados();
+
+    const int n = static_cast<int>(locais.size());
+    const double orcamentoKm = params.orcamentoKm();
+
+    if (n > MAX_LOCAIS_DP_ESPARSA) {
+        erros() << "Programacao Dinamica Esparsa suporta ate " << MAX_LOCAIS_DP_ESPARSA
+                << " locais (" << n << " carregados). Use resolverBranchAndBound.\n";
+        return resultado;
+    }
+
+    const auto ponteiroDistOrigem = obterDistanciasOrigem(params);
+    const std::vector<double>& distOrigem = *ponteiroDistOrigem;
+
+    // Um estado só é mantido se ainda puder voltar para S dentro do
+    // orçamento. Pela desigualdade triangular, nenhuma extensão de um estado
+    // descartado volta a caber, então o ótimo é o mesmo da DP densa.
+    auto cabeComVolta = [&](double custo, int ultimo) {
+        return custo + distOrigem[ultimo] <= orcamentoKm + EPSILON;
+    };
+
+    // CASO BASE: Origem S -> primeiro local
+
+    std::vector<std::vector<EstadoEsparso>> camadas(1);
+    for (int i = 0; i < n; ++i) {
+        if (cabeComVolta(distOrigem[i], i)) {
+            camadas[0].push_back({uint64_t(1) << i, distOrigem[i],
+                                  static_cast<uint8_t>(i), SEM_PREDECESSOR});
+        }
+    }
+
+    if (camadas[0].empty()) {
+        saida() << "Orcamento insuficiente para visitar qualquer local (ida + volta).\n";
+        auto fimTempo = std::chrono::high_resolution_clock::now();
+        resultado.tempoExecucaoMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            fimTempo - inicioTempo).count();
+        return resultado;
+    }
+
+    consolidarCamada(camadas[0]);
+
+    // Matriz de distâncias linearizada (no máximo 64 x 64) para o laço interno
+    std::vector<double> distancias(static_cast<std::size_t>(n) * n);
+    for (int u = 0; u < n; ++u) {
+        for (int v = 0; v < n; ++v) {
+            distancias[static_cast<std::size_t>(u) * n + v] = grafo.distancia(u, v);
+        }
+    }
+
+    resultado.metricas.preparacaoNs = cronometro.marcar();
+
+    // TRANSIÇÕES: expande a fronteira camada a camada (popcount crescente)
+
+    // Com prazo vencido, as camadas já prontas ainda dão a melhor rota até aqui
+    std::size_t totalEstados = camadas[0].size();
+    Contador expandidos;
+    Contador podados;
+    while (!camadas.back().empty()) {
+        std::vector<EstadoEsparso> proxima;
+        const std::vector<EstadoEsparso>& atual = camadas.back();
+
+        // Uma camada grande leva segundos: o prazo é consultado durante a
+        // expansão e a camada incompleta é descartada
+        for (std::size_t indice = 0; indice < atual.size(); ++indice) {
+            if (indice % ESTADOS_POR_VERIFICACAO == 0 && interrompida(params.interrupcao)) {
+                resultado.interrompida = true;
+                break;
+            }
+
+            const EstadoEsparso& estado = atual[indice];
+            const double* distU = distancias.data() + static_cast<std::size_t>(estado.ultimo) * n;
+
+            for (int v = 0; v < n; ++v) {
+                const uint64_t bitV = uint64_t(1) << v;
+                if (estado.mascara & bitV) continue;
+
+                const double novoCusto = estado.custo + distU[v];
+                if (!cabeComVolta(novoCusto, v)) {
+                    podados.somar();
+                    continue;
+                }
+
+                expandidos.somar();
+                proxima.push_back({estado.mascara | bitV, novoCusto,
+                                   static_cast<uint8_t>(v), estado.ultimo});
+            }
+        }
+
+        // A ordenação da consolidação não é interrompível: só começa dentro
+        // do prazo
+        if (resultado.interrompida || interrompida(params.interrupcao)) {
+            resultado.interrompida = true;
+            camadas.emplace_back();  // Removida logo abaixo, como a última camada vazia
+            break;
+        }
+
+        consolidarCamada(proxima);
+        totalEstados += proxima.size();
+        camadas.push_back(std::move(proxima));
+    }
+    camadas.pop_back();  // Última camada vazia
+    resultado.metricas.transicoesNs = cronometro.marcar();
+    resultado.metricas.estadosExpandidos = expandidos.total();
+    resultado.metricas.transicoesPodadas = podados.total();
+
+    // RECUPERAÇÃO DA MELHOR SOLUÇÃO (incluindo volta para S)
+    //
+    // Maior pontuação, depois menor custo e, por fim, menor (mascara, ultimo),
+    // o mesmo critério da varredura da DP densa
+
+    int melhorPontuacao = 0;
+    double melhorCustoTotal = INFINITO;
+    const EstadoEsparso* melhorEstado = nullptr;
+    std::size_t melhorCamada = 0;
+
+    for (std::size_t k = 0; k < camadas.size(); ++k) {
+        for (const auto& estado : camadas[k]) {
+            const double custoTotal = estado.custo + distOrigem[estado.ultimo];
+
+            int pontuacao = 0;
+            for (uint64_t restantes = estado.mascara; restantes; restantes &= restantes - 1) {
+                pontuacao += locais[__builtin_ctzll(restantes)].pontuacao;
+            }
+
+            bool melhor = pontuacao > melhorPontuacao ||
+                          (pontuacao == melhorPontuacao && custoTotal < melhorCustoTotal);
+            if (!melhor && melhorEstado && pontuacao == melhorPontuacao && custoTotal == melhorCustoTotal) {
+                melhor = estado.mascara < melhorEstado->mascara ||
+                         (estado.mascara == melhorEstado->mascara && estado.ultimo < melhorEstado->ultimo);
+            }
+
+            if (melhor) {
+                melhorPontuacao = pontuacao;
+                melhorCustoTotal = custoTotal;
+                melhorEstado = &estado;
+                melhorCamada = k;
+            }
+        }
+    }
+
+    resultado.metricas.recuperacaoNs = cronometro.marcar();
+
+    // RECONSTRUÇÃO DA ROTA
+
+    if (melhorEstado) {
+        std::vector<int> rota;
+        const EstadoEsparso* estado = melhorEstado;
+        std::size_t k = melhorCamada;
+
+        while (true) {
+            rota.push_back(estado->ultimo);
+            if (estado->predecessor == SEM_PREDECESSOR || k == 0) break;
+
+            const uint64_t mascaraAnterior = estado->mascara ^ (uint64_t(1) << estado->ultimo);
+            estado = buscarEstado(camadas[--k], mascaraAnterior, estado->predecessor);
+            if (!estado) break;  // Não deveria acontecer: o predecessor foi mantido
+        }
+
+        std::reverse(rota.begin(), rota.end());
+
+        resultado.rota = rota;
+        resultado.pontuacaoTotal = melhorPontuacao;
+        resultado.custoKm = melhorCustoTotal;
+        resultado.tempoHoras = melhorCustoTotal / params.velocidadeKmh;
+        resultado.solucaoValida = true;
+        resultado.otimoComprovado = !resultado.interrompida;
+    } else {
+        saida() << "Nenhuma rota valida encontrada dentro do orçamento de "
+                << params.orcamentoHoras << " horas (" << orcamentoKm << " km).\n";
+    }
+    resultado.metricas.reconstrucaoNs = cronometro.marcar();
+
+    saida() << "Estados alcancaveis: " << totalEstados << "\n";
+
+    // Tempo de execução
+    auto fimTempo = std::chrono::high_resolution_clock::now();
+    resultado.tempoExecucaoMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        fimTempo - inicioTempo).count();
+
+    return resultado;
+}
@@ -0,0 +1,91 @@
+#ifndef TABELA_DP_H
+#define TABELA_DP_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// TABELA DP CONTÍGUA
+//
+// Guarda custo e predecessor de cada estado (mascara, ultimo) em dois blocos
+// únicos de memória, com layout mascara-major: os n estados de uma máscara
+// ficam em posições consecutivas. O predecessor usa 8 bits, o que limita a
+// tabela a menos de 255 locais (muito acima do que a DP exata suporta).
+// Um byte por máscara marca as que têm algum estado finito: a transição
+// pula máscaras anteriores mortas sem varrer suas n entradas.
+//
+// Em float os custos são arredondados para cima (arredondarParaCima): a
+// tabela nunca subestima uma rota, então o que ela aceita cabe no orçamento.
+
+template <typename Custo>
+class TabelaDP {
+	public:
+	    using TipoCusto = Custo;
+	    
+	    static constexpr Custo INFINITO = std::numeric_limits<Custo>::max() / 2;
+	    static constexpr uint8_t SEM_PREDECESSOR = 0xFF;
+
+	    // Aloca (ou reaproveita) a tabela para n locais e reinicia os estados
+	    void preparar(int numLocais) {
+	        n = numLocais;
+	        const std::size_t total = (std::size_t(1) << n) * static_cast<std::size_t>(n);
+	        custos.assign(total, INFINITO);
+	        predecessores.assign(total, SEM_PREDECESSOR);
+	        vivas.assign(std::size_t(1) << n, 0);
+	    }
+
+	    int quantidadeLocais() const { return n; }
+
+	    // Memória que a tabela mantém entre consultas (capacidade dos vetores)
+	    std::size_t bytesReservados() const {
+	        return custos.capacity() * sizeof(Custo) + predecessores.capacity() + vivas.capacity();
+	    }
+
+	    // Devolve a memória ao sistema; o próximo preparar aloca de novo
+	    void liberar() {
+	        n = 0;
+	        std::vector<Custo>().swap(custos);
+	        std::vector<uint8_t>().swap(predecessores);
+	        std::vector<uint8_t>().swap(vivas);
+	    }
+
+	    // Custo a gravar na tabela, arredondado para cima: em float o valor
+	    // mais próximo pode ficar abaixo do custo real e uma rota que estoura
+	    // o orçamento passaria pela tabela. Para double não muda nada.
+	    static Custo arredondarParaCima(double custo) {
+	        Custo armazenado = static_cast<Custo>(custo);
+	        if (static_cast<double>(armazenado) < custo) {
+	            armazenado = std::nextafter(armazenado, std::numeric_limits<Custo>::infinity());
+	        }
+	        return armazenado;
+	    }
+
+	    Custo* custosMascara(int mascara) { return custos.data() + indice(mascara); }
+	    const Custo* custosMascara(int mascara) const { return custos.data() + indice(mascara); }
+
+	    uint8_t* predecessoresMascara(int mascara) { return predecessores.data() + indice(mascara); }
+	    const uint8_t* predecessoresMascara(int mascara) const { return predecessores.data() + indice(mascara); }
+
+	    bool viva(int mascara) const { return vivas[mascara] != 0; }
+	    void marcarViva(int mascara) { vivas[mascara] = 1; }
+
+	    // Bytes ocupados por uma tabela de n locais
+	    static std::size_t bytesNecessarios(int numLocais) {
+	        return (std::size_t(1) << numLocais) * static_cast<std::size_t>(numLocais) *
+	               (sizeof(Custo) + sizeof(uint8_t)) + (std::size_t(1) << numLocais);
+	    }
+
+	private:
+	    int n = 0;
+	    std::vector<Custo> custos;
+	    std::vector<uint8_t> predecessores;
+	    std::vector<uint8_t> vivas;
+
+	    std::size_t indice(int mascara) const {
+	        return static_cast<std::size_t>(mascara) * static_cast<std::size_t>(n);
+	    }
+};
+
+#endif // TABELA_DP_H
@@ -0,0 +1,204 @@
+#include "Solver.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+
+// BENCHMARKS DOS SOLVERS E DA CONSTRUÇÃO DO GRAFO
+//
+// Instâncias sintéticas com n locais espalhados por uma caixa de ~20 km em
+// torno do centro do Rio, geradas com semente fixa para que os números sejam
+// comparáveis entre execuções. A origem é sempre o centro da caixa.
+
+namespace {
+    constexpr double LATITUDE_CENTRO = -22.9068;
+    constexpr double LONGITUDE_CENTRO = -43.1729;
+    constexpr double VELOCIDADE_KMH = 10.0;
+
+    // Escreve (uma vez por n) um CSV no formato de dados_rio.csv
+    const std::string& arquivoSintetico(int n) {
+        static std::map<int, std::string> arquivos;
+
+        auto it = arquivos.find(n);
+        if (it != arquivos.end()) return it->second;
+
+        const std::string caminho = "benchmark_locais_" + std::to_string(n) + ".csv";
+        std::ofstream arquivo(caminho);
+        std::mt19937 gerador(12345u + static_cast<unsigned>(n));
+        std::uniform_real_distribution<double> deslocamento(-0.09, 0.09);
+        std::uniform_int_distribution<int> pontuacao(100, 10000);
+
+        arquivo.precision(12);
+        arquivo << "ID,Nome,Latitude,Longitude,Pontuacao\n";
+        for (int i = 0; i < n; ++i) {
+            arquivo << (i + 1) << ",Local_" << (i + 1) << ","
+                    << LATITUDE_CENTRO + deslocamento(gerador) << ","
+                    << LONGITUDE_CENTRO + deslocamento(gerador) << ","
+                    << pontuacao(gerador) << "\n";
+        }
+
+        return arquivos.emplace(n, caminho).first->second;
+    }
+
+    ParametrosViagem parametrosCentro(double orcamentoHoras) {
+        return {LATITUDE_CENTRO, LONGITUDE_CENTRO, orcamentoHoras, VELOCIDADE_KMH};
+    }
+
+    void prepararSolver(OrienteeringProblemSolver& solver, int n) {
+        solver.definirSilencioso(true);
+        solver.carregarDados(arquivoSintetico(n));
+        solver.construirGrafo();
+    }
+
+    void registrarResultado(benchmark::State& state, const ResultadoSolucao& resultado) {
+        state.counters["pontuacao"] = resultado.pontuacaoTotal;
+        state.counters["locais_rota"] = static_cast<double>(resultado.rota.size());
+        state.counters["estados_expandidos"] = static_cast<double>(resultado.metricas.estadosExpandidos);
+    }
+}
+
+// CARREGAMENTO E GRAFO
+
+static void BM_CarregarDados(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    const std::string& caminho = arquivoSintetico(n);
+
+    OrienteeringProblemSolver solver;
+    solver.definirSilencioso(true);
+    for (auto _ : state) {
+        solver.carregarDados(caminho);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_CarregarDados)->RangeMultiplier(4)->Range(16, 4096)->Unit(benchmark::kMicrosecond);
+
+static void BM_ConstruirGrafo(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+
+    OrienteeringProblemSolver solver;
+    solver.definirSilencioso(true);
+    solver.carregarDados(arquivoSintetico(n));
+    for (auto _ : state) {
+        solver.construirGrafo();
+    }
+    state.SetComplexityN(n);
+}
+BENCHMARK(BM_ConstruirGrafo)->RangeMultiplier(4)->Range(16, 4096)
+    ->Unit(benchmark::kMicrosecond)->Complexity(benchmark::oNSquared);
+
+static void BM_ConstruirGrafoEsparso(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+
+    OrienteeringProblemSolver solver;
+    solver.definirSilencioso(true);
+    solver.carregarDados(arquivoSintetico(n));
+    for (auto _ : state) {
+        solver.construirGrafoEsparso(16);
+    }
+    state.SetComplexityN(n);
+}
+BENCHMARK(BM_ConstruirGrafoEsparso)->RangeMultiplier(4)->Range(16, 4096)
+    ->Unit(benchmark::kMicrosecond)->Complexity(benchmark::oNLogN);
+
+// Snapshot gerado uma vez por n; mede só a carga (mmap + cópia dos locais)
+static void BM_CarregarSnapshot(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    const std::string caminho = "benchmark_locais_" + std::to_string(n) + ".grafo";
+
+    OrienteeringProblemSolver origem;
+    prepararSolver(origem, n);
+    origem.salvarSnapshot(caminho);
+
+    OrienteeringProblemSolver solver;
+    solver.definirSilencioso(true);
+    for (auto _ : state) {
+        solver.carregarSnapshot(caminho);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_CarregarSnapshot)->RangeMultiplier(4)->Range(16, 4096)->Unit(benchmark::kMicrosecond);
+
+// SOLVERS
+//
+// Argumentos: {n, orçamento em décimos de hora}
+
+static void BM_ResolverGuloso(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    const ParametrosViagem params = parametrosCentro(state.range(1) / 10.0);
+
+    OrienteeringProblemSolver solver;
+    prepararSolver(solver, n);
+
+    ResultadoSolucao resultado;
+    for (auto _ : state) {
+        resultado = solver.resolverGuloso(params);
+        benchmark::DoNotOptimize(resultado);
+    }
+    registrarResultado(state, resultado);
+}
+BENCHMARK(BM_ResolverGuloso)
+    ->ArgsProduct({{20, 200, 2000}, {5, 20, 60}})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_ResolverGulosoComBuscaLocal(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    const ParametrosViagem params = parametrosCentro(state.range(1) / 10.0);
+
+    OrienteeringProblemSolver solver;
+    prepararSolver(solver, n);
+
+    ResultadoSolucao resultado;
+    for (auto _ : state) {
+        resultado = solver.resolverGulosoComBuscaLocal(params);
+        benchmark::DoNotOptimize(resultado);
+    }
+    registrarResultado(state, resultado);
+}
+BENCHMARK(BM_ResolverGulosoComBuscaLocal)
+    ->ArgsProduct({{20, 200, 2000}, {5, 20, 60}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Iterações fixas e sem limite de tempo, para medir custo por iteração
+static void BM_ResolverGRASP(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    const ParametrosViagem params = parametrosCentro(state.range(1) / 10.0);
+
+    OrienteeringProblemSolver solver;
+    prepararSolver(solver, n);
+
+    OpcoesGRASP opcoes;
+    opcoes.maxIteracoes = 64;
+    opcoes.tempoLimiteMs = 0;
+
+    ResultadoSolucao resultado;
+    for (auto _ : state) {
+        resultado = solver.resolverGRASP(params, opcoes);
+        benchmark::DoNotOptimize(resultado);
+    }
+    registrarResultado(state, resultado);
+}
+BENCHMARK(BM_ResolverGRASP)
+    ->ArgsProduct({{20, 200}, {5, 20, 60}})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_ResolverProgramacaoDinamica(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    const ParametrosViagem params = parametrosCentro(state.range(1) / 10.0);
+
+    OrienteeringProblemSolver solver;
+    prepararSolver(solver, n);
+
+    ResultadoSolucao resultado;
+    for (auto _ : state) {
+        resultado = solver.resolverProgramacaoDinamica(params);
+        benchmark::DoNotOptimize(resultado);
+    }
+    registrarResultado(state, resultado);
+}
+BENCHMARK(BM_ResolverProgramacaoDinamica)
+    ->ArgsProduct({{12, 16, 20}, {5, 20, 60}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
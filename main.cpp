@@ -1,7 +1,14 @@
 #include "Solver.h"
+#include "Servidor.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 
 // FUNÇÕES AUXILIARES
 
@@ -157,10 +164,223 @@ void compararResultados(const ResultadoSolucao& dp,
     std::cout << "\n";
 }
 
+// CARGA DO CATÁLOGO
+
+// Usa o snapshot binário ao lado do CSV (dados_rio.grafo) quando ele existe e
+// é mais novo que o CSV; caso contrário lê o CSV e constrói o grafo
+void carregarCatalogo(OrienteeringProblemSolver& solver, const std::string& arquivoCsv) {
+    namespace fs = std::filesystem;
+    
+    const fs::path arquivoSnapshot = fs::path(arquivoCsv).replace_extension(".grafo");
+    std::error_code erro;
+    const bool snapshotAtual = fs::exists(arquivoSnapshot, erro) &&
+        (!fs::exists(arquivoCsv, erro) ||
+         fs::last_write_time(arquivoSnapshot, erro) >= fs::last_write_time(arquivoCsv, erro));
+    
+    // Snapshot de versão antiga, corrompido ou ilegível: volta para o CSV.
+    // carregarSnapshot só altera o solver depois de validar o arquivo inteiro.
+    if (snapshotAtual) {
+        try {
+            solver.carregarSnapshot(arquivoSnapshot.string());
+            return;
+        } catch (const std::exception& e) {
+            std::cerr << "Aviso: " << e.what() << "; usando " << arquivoCsv << ".\n";
+        }
+    }
+    
+    solver.carregarDados(arquivoCsv);
+    solver.construirGrafo();
+}
+
+// Lê o CSV, constrói o grafo denso e grava o snapshot para as próximas execuções
+int executarModoGerarSnapshot(const std::string& arquivoCsv, const std::string& arquivoSnapshot) {
+    OrienteeringProblemSolver solver;
+    solver.carregarDados(arquivoCsv);
+    solver.construirGrafo();
+    solver.salvarSnapshot(arquivoSnapshot);
+    return 0;
+}
+
+// MODO SERVIDOR
+
+// Carrega os catálogos uma vez (nome = arquivo sem extensão) e atende
+// consultas pelo socket até SIGINT/SIGTERM
+int executarModoServidor(const std::string& endereco, const std::vector<std::string>& arquivosCsv) {
+    ServidorSolver servidor;
+    
+    for (const auto& arquivoCsv : arquivosCsv) {
+        auto solver = std::make_unique<OrienteeringProblemSolver>();
+        solver->definirSilencioso(true);
+        carregarCatalogo(*solver, arquivoCsv);
+        servidor.adicionarCatalogo(std::filesystem::path(arquivoCsv).stem().string(), std::move(solver));
+    }
+    
+    return servidor.executar(endereco);
+}
+
+// MODO LOTE
+
+// Lê consultas no formato Latitude,Longitude,OrcamentoHoras,VelocidadeKmh
+// (com cabeçalho) e escreve um CSV de resultados na saída padrão. Com
+// memoriaDPMB > 0, a DP que não couber nesse teto vira busca em feixe.
+int executarModoLote(const std::string& arquivoConsultas, Algoritmo algoritmo, double memoriaDPMB,
+                     const std::string& arquivoMetricas) {
+    std::ifstream arquivo(arquivoConsultas);
+    if (!arquivo.is_open()) {
+        throw std::runtime_error("Impossivel abrir o arquivo: " + arquivoConsultas);
+    }
+    
+    std::vector<ParametrosViagem> consultas;
+    std::string linha;
+    std::getline(arquivo, linha);  // Cabeçalho
+    
+    int linhaAtual = 1;
+    while (std::getline(arquivo, linha)) {
+        ++linhaAtual;
+        if (linha.empty()) continue;
+        
+        std::stringstream ss(linha);
+        ParametrosViagem params;
+        char separador;
+        if (!(ss >> params.latitudePartida >> separador >> params.longitudePartida >> separador
+                 >> params.orcamentoHoras >> separador >> params.velocidadeKmh)) {
+            std::cerr << "Aviso: Consulta invalida na linha " << linhaAtual << ", ignorando.\n";
+            continue;
+        }
+        consultas.push_back(params);
+    }
+    
+    OrienteeringProblemSolver solver;
+    solver.definirSilencioso(true);
+    carregarCatalogo(solver, "dados_rio.csv");
+    
+    // Senão toda linha sairia inválida, sem dizer por quê
+    if (!solver.suportaAlgoritmo(algoritmo)) {
+        throw std::runtime_error(std::string(nomeAlgoritmo(algoritmo)) +
+                                 " nao segue visitas nem janelas de horario; use dp, guloso, guloso-bl ou auto");
+    }
+    
+    OpcoesDP opcoesDP;
+    opcoesDP.memoriaMaximaBytes = static_cast<std::size_t>(memoriaDPMB * 1024.0 * 1024.0);
+    
+    auto inicio = std::chrono::steady_clock::now();
+    const auto resultados = solver.resolverLote(consultas, algoritmo, 0, opcoesDP);
+    auto fim = std::chrono::steady_clock::now();
+    
+    std::cout << "Consulta,Valida,Pontuacao,DistanciaKm,TempoHoras,Rota,Otimo\n";
+    for (std::size_t i = 0; i < resultados.size(); ++i) {
+        const auto& resultado = resultados[i];
+        std::cout << (i + 1) << "," << (resultado.solucaoValida ? 1 : 0) << ","
+                  << resultado.pontuacaoTotal << ","
+                  << std::fixed << std::setprecision(3) << resultado.custoKm << ","
+                  << std::setprecision(3) << resultado.tempoHoras << ",";
+        for (std::size_t j = 0; j < resultado.rota.size(); ++j) {
+            std::cout << (j ? "-" : "") << solver.obterLocal(resultado.rota[j]).id;
+        }
+        std::cout << "," << (resultado.otimoComprovado ? 1 : 0) << "\n";
+    }
+    
+    const double segundos = std::chrono::duration<double>(fim - inicio).count();
+    std::cerr << resultados.size() << " consultas em " << std::fixed << std::setprecision(3)
+              << segundos * 1000.0 << " ms";
+    if (segundos > 0.0) {
+        std::cerr << " (" << std::setprecision(0) << resultados.size() / segundos << " consultas/s)";
+    }
+    std::cerr << "\n";
+    
+    // Métricas somadas de todas as consultas, para o coletor do Prometheus
+    if (!arquivoMetricas.empty()) {
+        MetricasSolucao total;
+        for (const auto& resultado : resultados) {
+            total += resultado.metricas;
+        }
+        
+        std::ofstream saidaMetricas(arquivoMetricas);
+        if (!saidaMetricas.is_open()) {
+            throw std::runtime_error("Impossivel escrever o arquivo: " + arquivoMetricas);
+        }
+        escreverMetricasPrometheus(saidaMetricas, total, nomeAlgoritmo(algoritmo));
+    }
+    
+    return 0;
+}
+
+// MODO FRONTEIRA
+
+// Uma única DP para a origem dada; escreve a fronteira custo x pontuação,
+// que responde qualquer orçamento partindo dessa origem
+int executarModoFronteira(double latitude, double longitude) {
+    OrienteeringProblemSolver solver;
+    solver.definirSilencioso(true);
+    carregarCatalogo(solver, "dados_rio.csv");
+    
+    OpcoesDP opcoesDP;
+    opcoesDP.numThreads = 0;
+    
+    auto inicio = std::chrono::steady_clock::now();
+    const FronteiraPareto fronteira = solver.construirFronteiraPareto(latitude, longitude, opcoesDP);
+    auto fim = std::chrono::steady_clock::now();
+    
+    std::cout << "Ponto,Pontuacao,DistanciaKm,Rota\n";
+    for (std::size_t i = 0; i < fronteira.pontos.size(); ++i) {
+        const auto& ponto = fronteira.pontos[i];
+        std::cout << (i + 1) << "," << ponto.pontuacao << ","
+                  << std::fixed << std::setprecision(3) << ponto.custoKm << ",";
+        for (std::size_t j = 0; j < ponto.rota.size(); ++j) {
+            std::cout << (j ? "-" : "") << solver.obterLocal(ponto.rota[j]).id;
+        }
+        std::cout << "\n";
+    }
+    
+    std::cerr << fronteira.pontos.size() << " pontos em " << std::fixed << std::setprecision(3)
+              << std::chrono::duration<double>(fim - inicio).count() * 1000.0 << " ms\n";
+    
+    return 0;
+}
+
 // FUNÇÃO PRINCIPAL
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
+        // Modo lote: otimizador --lote consultas.csv [guloso|guloso-bl|dp|dp-esparsa|bb|grasp|auto] [memoria-dp-MB]
+        //            [metricas.prom]
+        if (argc >= 3 && std::string(argv[1]) == "--lote") {
+            Algoritmo algoritmo = Algoritmo::Guloso;
+            if (argc >= 4 && !interpretarAlgoritmo(argv[3], algoritmo)) {
+                std::cerr << "Algoritmo desconhecido: " << argv[3] << "\n";
+                return 1;
+            }
+            const double memoriaDPMB = (argc >= 5) ? std::stod(argv[4]) : 0.0;
+            return executarModoLote(argv[2], algoritmo, memoriaDPMB, argc >= 6 ? argv[5] : "");
+        }
+        
+        // Servidor: otimizador --servidor (porta|caminho-do-socket) [catalogo.csv ...]
+        if (argc >= 3 && std::string(argv[1]) == "--servidor") {
+            std::vector<std::string> catalogos(argv + 3, argv + argc);
+            if (catalogos.empty()) catalogos.push_back("dados_rio.csv");
+            return executarModoServidor(argv[2], catalogos);
+        }
+        
+        // Cliente de teste: otimizador --cliente (porta|caminho-do-socket) consultas.csv [algoritmo] [em-voo]
+        if (argc >= 4 && std::string(argv[1]) == "--cliente") {
+            return executarClienteServidor(argv[2], argv[3], argc >= 5 ? argv[4] : "guloso",
+                                           argc >= 6 ? std::stoi(argv[5]) : 1);
+        }
+        
+        // Modo fronteira: otimizador --fronteira latitude longitude
+        if (argc >= 4 && std::string(argv[1]) == "--fronteira") {
+            return executarModoFronteira(std::stod(argv[2]), std::stod(argv[3]));
+        }
+        
+        // Snapshot binário: otimizador --gerar-snapshot dados_rio.csv dados_rio.grafo
+        if (argc >= 4 && std::string(argv[1]) == "--gerar-snapshot") {
+            return executarModoGerarSnapshot(argv[2], argv[3]);
+        }
+        
+        // Interativo: otimizador [--comparar]. Sem --comparar, o despacho
+        // híbrido escolhe um solver; com ele, roda DP e guloso e compara
+        const bool comparar = argc >= 2 && std::string(argv[1]) == "--comparar";
+        
         exibirCabecalho();
         
         // Inicializar solver
@@ -169,8 +389,7 @@ int main() {
         
         // Carregar dados
         std::cout << "Carregando dados de " << arquivoCsv << "...\n";
-        solver.carregarDados(arquivoCsv);
-        solver.construirGrafo();
+        carregarCatalogo(solver, arquivoCsv);
         
         // Opcionalmente exibir locais (descomente se necessário)
         // solver.exibirLocais();
@@ -184,18 +403,37 @@ int main() {
         
         exibirResumoParametros(parametros);
         
-        // Executar ambos os algoritmos
-        std::cout << "Executando algoritmos...\n";
+        OpcoesDP opcoesDP;
+        opcoesDP.numThreads = 0;  // Todas as camadas da DP em todos os núcleos
         
-        auto resultadoDP = solver.resolverProgramacaoDinamica(parametros);
-        auto resultadoGuloso = solver.resolverGuloso(parametros);
-        
-        // Exibir resultados
-        solver.exibirResultado(resultadoDP, "PROGRAMACAO DINAMICA (OTIMO)");
-        solver.exibirResultado(resultadoGuloso, "ALGORITMO GULOSO (HEURISTICA)");
-        
-        // Comparação
-        compararResultados(resultadoDP, resultadoGuloso);
+        if (comparar) {
+            // Executar ambos os algoritmos
+            std::cout << "Executando algoritmos...\n";
+            
+            // Catálogos grandes demais para a DP usam o branch-and-bound exato
+            auto resultadoDP = (solver.quantidadeLocais() <= OrienteeringProblemSolver::MAX_LOCAIS_DP)
+                ? solver.resolverProgramacaoDinamica(parametros, opcoesDP)
+                : solver.resolverBranchAndBound(parametros);
+            auto resultadoGuloso = solver.resolverGuloso(parametros);
+            
+            // Exibir resultados
+            solver.exibirResultado(resultadoDP, "PROGRAMACAO DINAMICA (OTIMO)");
+            solver.exibirResultado(resultadoGuloso, "ALGORITMO GULOSO (HEURISTICA)");
+            
+            // Comparação
+            compararResultados(resultadoDP, resultadoGuloso);
+        } else {
+            // Ótimo quando couber em 2 s; senão, a melhor heurística que couber
+            SLAConsulta sla;
+            sla.latenciaMaximaMs = 2000;
+            sla.opcoesDP = opcoesDP;
+            
+            DecisaoDespacho decisao;
+            auto resultado = solver.resolver(parametros, sla, &decisao);
+            
+            solver.exibirResultado(resultado, std::string("DESPACHO AUTOMATICO (") +
+                                   nomeAlgoritmo(decisao.algoritmo) + ")");
+        }
         
         std::cout << "Execucaoo concluIda com sucesso!\n\n";
         
@@ -0,0 +1,251 @@
+#ifndef APOIO_TESTES_H
+#define APOIO_TESTES_H
+
+#include "Haversine.h"
+#include "Solver.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+// APOIO DOS TESTES
+//
+// Sem framework: cada teste é um executável que conta as falhas de
+// VERIFICAR e termina com código 1 se houver alguma (é o que o ctest lê).
+// As instâncias são pequenas e geradas com semente fixa, e a referência é
+// uma força bruta sobre todas as rotas, escrita à parte dos solvers: ela
+// só compartilha com eles a distância entre dois pontos (Haversine.h) e o
+// PerfilVelocidade.
+
+namespace teste {
+    inline int falhas = 0;
+
+    inline void registrarFalha(const char* arquivo, int linha, const char* expressao, const std::string& contexto) {
+        ++falhas;
+        std::fprintf(stderr, "%s:%d: falhou: %s%s%s\n", arquivo, linha, expressao,
+                     contexto.empty() ? "" : " -- ", contexto.c_str());
+    }
+
+    inline int resultado(const char* nomeTeste) {
+        if (falhas > 0) {
+            std::fprintf(stderr, "%s: %d falha(s)\n", nomeTeste, falhas);
+            return 1;
+        }
+        std::printf("%s: ok\n", nomeTeste);
+        return 0;
+    }
+
+    constexpr double SEM_JANELA = std::numeric_limits<double>::infinity();
+    constexpr double TOLERANCIA = 1e-9;
+
+    // CATÁLOGOS SINTÉTICOS
+
+    struct LocalTeste {
+        double latitude;
+        double longitude;
+        int pontuacao;
+        double duracaoHoras = 0.0;
+        double aberturaHoras = -SEM_JANELA;
+        double fechamentoHoras = SEM_JANELA;
+    };
+
+    struct Instancia {
+        std::vector<LocalTeste> locais;
+        double latitudeOrigem = -22.95;
+        double longitudeOrigem = -43.22;
+    };
+
+    // n locais numa caixa de ~15 km em torno da origem
+    inline Instancia gerarInstancia(std::mt19937& gerador, int n, int pontuacaoMaxima = 100) {
+        std::uniform_real_distribution<double> latitude(-23.02, -22.88);
+        std::uniform_real_distribution<double> longitude(-43.30, -43.14);
+        std::uniform_int_distribution<int> pontuacao(1, pontuacaoMaxima);
+
+        Instancia instancia;
+        for (int i = 0; i < n; ++i) {
+            instancia.locais.push_back({latitude(gerador), longitude(gerador), pontuacao(gerador)});
+        }
+        return instancia;
+    }
+
+    // Visitas de até 20 min e, em parte dos locais, janelas de 1 a 3 h entre 8h e 12h
+    inline void sortearJanelas(std::mt19937& gerador, Instancia& instancia) {
+        std::uniform_real_distribution<double> duracao(0.0, 1.0 / 3.0);
+        std::uniform_real_distribution<double> abertura(8.0, 10.0);
+        std::uniform_real_distribution<double> largura(1.0, 3.0);
+        std::bernoulli_distribution comJanela(0.6);
+
+        for (LocalTeste& local : instancia.locais) {
+            local.duracaoHoras = duracao(gerador);
+            if (comJanela(gerador)) {
+                local.aberturaHoras = abertura(gerador);
+                local.fechamentoHoras = local.aberturaHoras + largura(gerador);
+            }
+        }
+    }
+
+    // CSV no formato de dados_rio.csv; com horário, as três colunas opcionais
+    inline void escreverCsv(const std::string& caminho, const Instancia& instancia, bool comHorario = false) {
+        std::ofstream arquivo(caminho);
+        arquivo.precision(17);
+        arquivo << "ID,Nome,Latitude,Longitude,Pontuacao";
+        if (comHorario) arquivo << ",DuracaoHoras,AberturaHoras,FechamentoHoras";
+        arquivo << "\n";
+
+        for (std::size_t i = 0; i < instancia.locais.size(); ++i) {
+            const LocalTeste& local = instancia.locais[i];
+            arquivo << (i + 1) << ",Local " << (i + 1) << "," << local.latitude << "," << local.longitude
+                    << "," << local.pontuacao;
+            if (comHorario) {
+                arquivo << "," << local.duracaoHoras << ",";
+                if (local.aberturaHoras > -SEM_JANELA) arquivo << local.aberturaHoras;
+                arquivo << ",";
+                if (local.fechamentoHoras < SEM_JANELA) arquivo << local.fechamentoHoras;
+            }
+            arquivo << "\n";
+        }
+    }
+
+    inline void carregar(OrienteeringProblemSolver& solver, const std::string& caminho) {
+        solver.definirSilencioso(true);
+        solver.definirRegistroDespacho([](const std::string&) {});
+        solver.carregarDados(caminho);
+        solver.construirGrafo(1);
+    }
+
+    // ROTAS DE REFERÊNCIA
+
+    class Referencia {
+    public:
+        // perfil vazio = velocidade constante; o modo horário vale com perfil
+        // ou com algum local com visita ou janela, como no solver
+        Referencia(const Instancia& instancia, const ParametrosViagem& params,
+                   const PerfilVelocidade& perfil = PerfilVelocidade())
+            : instancia(instancia), params(params), perfil(perfil),
+              n(static_cast<int>(instancia.locais.size())),
+              distancias(static_cast<std::size_t>(n) * n), distanciasOrigem(n)
+        {
+            const PontoEsferico origem = PontoEsferico::deGraus(instancia.latitudeOrigem, instancia.longitudeOrigem);
+            for (int i = 0; i < n; ++i) {
+                const PontoEsferico a = PontoEsferico::deGraus(instancia.locais[i].latitude, instancia.locais[i].longitude);
+                distanciasOrigem[i] = distanciaCordaKm(origem, a);
+                for (int j = 0; j < n; ++j) {
+                    const LocalTeste& outro = instancia.locais[j];
+                    distancias[i * n + j] = distanciaCordaKm(a, PontoEsferico::deGraus(outro.latitude, outro.longitude));
+                }
+            }
+
+            modoHorario = !perfil.vazio();
+            for (const LocalTeste& local : instancia.locais) {
+                if (local.duracaoHoras > 0.0 || local.aberturaHoras > -SEM_JANELA || local.fechamentoHoras < SEM_JANELA) {
+                    modoHorario = true;
+                }
+            }
+        }
+
+        struct Avaliacao {
+            bool viavel = true;
+            int pontuacao = 0;
+            double km = 0.0;
+            double horaVolta = 0.0;
+        };
+
+        // Percorre a rota como o enunciado descreve, sem nada dos solvers
+        Avaliacao avaliar(const std::vector<int>& rota) const {
+            Avaliacao avaliacao;
+            double horario = params.horaPartida;
+            int anterior = -1;
+            for (int local : rota) {
+                const double km = distancia(anterior, local);
+                avaliacao.km += km;
+                if (!visitar(local, viajar(horario, km), horario)) avaliacao.viavel = false;
+                avaliacao.pontuacao += instancia.locais[local].pontuacao;
+                anterior = local;
+            }
+            const double volta = rota.empty() ? 0.0 : distancia(anterior, -1);
+            avaliacao.km += volta;
+            avaliacao.horaVolta = viajar(horario, volta);
+
+            const bool dentro = modoHorario
+                ? avaliacao.horaVolta <= params.horaPartida + params.orcamentoHoras + TOLERANCIA
+                : avaliacao.km <= params.orcamentoKm() + TOLERANCIA;
+            avaliacao.viavel = avaliacao.viavel && dentro;
+            return avaliacao;
+        }
+
+        // Maior pontuação entre todas as rotas viáveis e, entre as que a
+        // atingem, o menor km
+        Avaliacao melhor() const {
+            Avaliacao melhorRota;
+            std::vector<bool> visitado(n, false);
+            explorar(-1, 0.0, params.horaPartida, 0, visitado, melhorRota);
+            return melhorRota;
+        }
+
+    private:
+        const Instancia& instancia;
+        const ParametrosViagem params;
+        const PerfilVelocidade perfil;
+        const int n;
+        std::vector<double> distancias;
+        std::vector<double> distanciasOrigem;
+        bool modoHorario = false;
+
+        // -1 é a origem
+        double distancia(int a, int b) const {
+            if (a < 0) return distanciasOrigem[b];
+            if (b < 0) return distanciasOrigem[a];
+            return distancias[static_cast<std::size_t>(a) * n + b];
+        }
+
+        double viajar(double horario, double km) const {
+            return perfil.vazio() ? horario + km / params.velocidadeKmh
+                                  : perfil.chegada(horario, km, params.velocidadeKmh, 0);
+        }
+
+        // Espera a abertura e soma a visita; false se ela passa do fechamento
+        bool visitar(int local, double chegada, double& saida) const {
+            const LocalTeste& dados = instancia.locais[local];
+            saida = std::max(chegada, dados.aberturaHoras) + dados.duracaoHoras;
+            return saida <= dados.fechamentoHoras + TOLERANCIA;
+        }
+
+        void explorar(int ultimo, double km, double horario, int pontuacao, std::vector<bool>& visitado,
+                      Avaliacao& melhorRota) const {
+            const double volta = ultimo < 0 ? 0.0 : distancia(ultimo, -1);
+            const bool fecha = modoHorario
+                ? viajar(horario, volta) <= params.horaPartida + params.orcamentoHoras + TOLERANCIA
+                : km + volta <= params.orcamentoKm() + TOLERANCIA;
+            if (!fecha) return;  // Desigualdade triangular (e FIFO): estender não ajuda
+
+            if (pontuacao > melhorRota.pontuacao ||
+                (pontuacao == melhorRota.pontuacao && pontuacao > 0 && km + volta < melhorRota.km)) {
+                melhorRota.pontuacao = pontuacao;
+                melhorRota.km = km + volta;
+            }
+
+            for (int proximo = 0; proximo < n; ++proximo) {
+                if (visitado[proximo]) continue;
+                const double trecho = distancia(ultimo, proximo);
+                double saida;
+                if (!visitar(proximo, viajar(horario, trecho), saida)) continue;
+
+                visitado[proximo] = true;
+                explorar(proximo, km + trecho, saida, pontuacao + instancia.locais[proximo].pontuacao,
+                         visitado, melhorRota);
+                visitado[proximo] = false;
+            }
+        }
+    };
+}
+
+#define VERIFICAR(expressao) \
+    do { if (!(expressao)) teste::registrarFalha(__FILE__, __LINE__, #expressao, ""); } while (0)
+
+#define VERIFICAR_CONTEXTO(expressao, contexto) \
+    do { if (!(expressao)) teste::registrarFalha(__FILE__, __LINE__, #expressao, (contexto)); } while (0)
+
+#endif // APOIO_TESTES_H
@@ -0,0 +1,392 @@
+#include "ApoioTestes.h"
+#include "EspacoTrabalho.h"
+#include "IndiceEspacial.h"
+#include "Interrupcao.h"
+#include <cmath>
+#include <string>
+#include <utility>
+
+// SOLVERS EXATOS CONTRA A FORÇA BRUTA (VELOCIDADE CONSTANTE)
+//
+// DP densa (double e float), DP esparsa, branch-and-bound, fronteira de
+// Pareto e despacho "otima" sem latência precisam achar a pontuação máxima
+// da força bruta; os que comprovam o ótimo, também o menor km. Guloso e
+// busca local só precisam devolver rotas viáveis. Com teto de memória, a
+// busca em feixe só pode comprovar o ótimo quando acha a pontuação da força
+// bruta, e com o prazo esgotado quem para não comprova o ótimo. O grafo k-NN
+// precisa guardar os k vizinhos mais próximos de verdade, com a distância
+// densa, e o kernel de distâncias em lote precisa seguir a fórmula de
+// Haversine.
+
+namespace {
+    const std::string ARQUIVO = "teste_dp.csv";
+    constexpr double VELOCIDADE_KMH = 30.0;
+
+    std::string descrever(int n, double orcamentoHoras, const char* solver) {
+        return std::string(solver) + ", n=" + std::to_string(n) + ", orcamento=" + std::to_string(orcamentoHoras) + " h";
+    }
+
+    void verificarRota(const teste::Referencia& referencia, const ResultadoSolucao& resultado,
+                       const std::string& contexto) {
+        if (!resultado.solucaoValida) return;
+        const auto avaliacao = referencia.avaliar(resultado.rota);
+        VERIFICAR_CONTEXTO(avaliacao.viavel, contexto);
+        VERIFICAR_CONTEXTO(avaliacao.pontuacao == resultado.pontuacaoTotal, contexto);
+        VERIFICAR_CONTEXTO(std::fabs(avaliacao.km - resultado.custoKm) < 1e-6, contexto);
+    }
+
+    void verificarOtimo(const teste::Referencia& referencia, const teste::Referencia::Avaliacao& otimo,
+                        const ResultadoSolucao& resultado, bool conferirKm, const std::string& contexto) {
+        VERIFICAR_CONTEXTO(resultado.pontuacaoTotal == otimo.pontuacao, contexto + ": pontuacao " +
+                           std::to_string(resultado.pontuacaoTotal) + ", esperada " + std::to_string(otimo.pontuacao));
+        if (otimo.pontuacao > 0) {
+            VERIFICAR_CONTEXTO(resultado.solucaoValida, contexto);
+            if (conferirKm) VERIFICAR_CONTEXTO(std::fabs(resultado.custoKm - otimo.km) < 1e-6, contexto);
+        }
+        verificarRota(referencia, resultado, contexto);
+    }
+
+    void compararComForcaBruta() {
+        std::mt19937 gerador(2024);
+        for (int caso = 0; caso < 120; ++caso) {
+            const int n = 1 + caso % 8;
+            const teste::Instancia instancia = teste::gerarInstancia(gerador, n, caso % 4 == 0 ? 3 : 100);
+            teste::escreverCsv(ARQUIVO, instancia);
+
+            OrienteeringProblemSolver solver;
+            teste::carregar(solver, ARQUIVO);
+            const FronteiraPareto fronteira =
+                solver.construirFronteiraPareto(instancia.latitudeOrigem, instancia.longitudeOrigem);
+
+            for (double orcamentoHoras : {0.2, 0.5, 0.9, 1.5, 3.0}) {
+                ParametrosViagem params{instancia.latitudeOrigem, instancia.longitudeOrigem,
+                                        orcamentoHoras, VELOCIDADE_KMH};
+                const teste::Referencia referencia(instancia, params);
+                const auto otimo = referencia.melhor();
+
+                OpcoesDP simples;
+                simples.precisaoSimples = true;
+                SLAConsulta sla;
+                sla.latenciaMaximaMs = 0;
+
+                verificarOtimo(referencia, otimo, solver.resolverProgramacaoDinamica(params), true,
+                               descrever(n, orcamentoHoras, "dp"));
+                verificarOtimo(referencia, otimo, solver.resolverProgramacaoDinamica(params, simples), false,
+                               descrever(n, orcamentoHoras, "dp float"));
+                verificarOtimo(referencia, otimo, solver.resolverProgramacaoDinamicaEsparsa(params), true,
+                               descrever(n, orcamentoHoras, "dp esparsa"));
+                verificarOtimo(referencia, otimo, solver.resolverBranchAndBound(params), true,
+                               descrever(n, orcamentoHoras, "bb"));
+                verificarOtimo(referencia, otimo, solver.consultarFronteira(fronteira, params), true,
+                               descrever(n, orcamentoHoras, "fronteira"));
+                verificarOtimo(referencia, otimo, solver.resolver(params, sla), true,
+                               descrever(n, orcamentoHoras, "auto"));
+
+                verificarRota(referencia, solver.resolverGuloso(params), descrever(n, orcamentoHoras, "guloso"));
+                verificarRota(referencia, solver.resolverGulosoComBuscaLocal(params),
+                              descrever(n, orcamentoHoras, "guloso-bl"));
+            }
+        }
+    }
+
+    // Orçamento no limite da rota ótima: a tabela em float arredonda para
+    // cima, então a rota que ela aceita nunca passa do orçamento
+    void floatNoLimiteDoOrcamento() {
+        std::mt19937 gerador(7);
+        for (int caso = 0; caso < 60; ++caso) {
+            const teste::Instancia instancia = teste::gerarInstancia(gerador, 10);
+            teste::escreverCsv(ARQUIVO, instancia);
+
+            OrienteeringProblemSolver solver;
+            teste::carregar(solver, ARQUIVO);
+
+            ParametrosViagem params{instancia.latitudeOrigem, instancia.longitudeOrigem, 1.0, VELOCIDADE_KMH};
+            const ResultadoSolucao exato = solver.resolverProgramacaoDinamica(params);
+            if (!exato.solucaoValida) continue;
+
+            for (double folgaKm : {-3e-6, -1e-6, -3e-7, 0.0, 3e-7}) {
+                ParametrosViagem limite = params;
+                limite.orcamentoHoras = (exato.custoKm + folgaKm) / VELOCIDADE_KMH;
+                const teste::Referencia referencia(instancia, limite);
+
+                OpcoesDP simples;
+                simples.precisaoSimples = true;
+                const ResultadoSolucao resultado = solver.resolverProgramacaoDinamica(limite, simples);
+                VERIFICAR_CONTEXTO(resultado.solucaoValida, "folga " + std::to_string(folgaKm * 1e6) + " mm");
+                verificarRota(referencia, resultado, "dp float no limite");
+            }
+        }
+    }
+
+    // Cada linha do k-NN tem k vizinhos distintos, ordenados por índice, com a
+    // distância da matriz densa e entre os k mais próximos
+    void verificarGrafoEsparso(const teste::Instancia& instancia, int k, const std::string& contexto) {
+        std::vector<double> latitudes, longitudes;
+        for (const teste::LocalTeste& local : instancia.locais) {
+            latitudes.push_back(local.latitude);
+            longitudes.push_back(local.longitude);
+        }
+        const int n = static_cast<int>(latitudes.size());
+        IndiceEspacial indice;
+        indice.construir(instancia.locais, RAIO_TERRA_KM);
+        GrafoDistancias denso, esparso;
+        denso.construirDenso(latitudes, longitudes, 1);
+        esparso.construirEsparso(latitudes, longitudes, indice, k, 1);
+
+        const GrafoDistancias::Visao visao = esparso.visao();
+        VERIFICAR_CONTEXTO(visao.vizinhosPorLocal == std::min(k, n - 1), contexto);
+        if (visao.vizinhosPorLocal != std::min(k, n - 1)) return;
+
+        for (int i = 0; i < n; ++i) {
+            std::vector<double> linha;
+            for (int j = 0; j < n; ++j) {
+                if (j != i) linha.push_back(denso.distancia(i, j));
+            }
+            std::sort(linha.begin(), linha.end());
+
+            const std::string local = contexto + ", local " + std::to_string(i);
+            for (int v = 0; v < visao.vizinhosPorLocal; ++v) {
+                const std::size_t posicao = static_cast<std::size_t>(i) * visao.vizinhosPorLocal + v;
+                const int j = visao.vizinhos[posicao];
+                VERIFICAR_CONTEXTO(j >= 0 && j < n && j != i, local);
+                if (j < 0 || j >= n || j == i) continue;
+                VERIFICAR_CONTEXTO(v == 0 || visao.vizinhos[posicao - 1] < j, local);
+                VERIFICAR_CONTEXTO(visao.distanciasVizinhos[posicao] == denso.distancia(i, j), local);
+                VERIFICAR_CONTEXTO(denso.distancia(i, j) <= linha[visao.vizinhosPorLocal - 1], local);
+            }
+            for (int j = 0; j < n; ++j) {
+                VERIFICAR_CONTEXTO(esparso.distancia(i, j) == denso.distancia(i, j), local);
+            }
+        }
+    }
+
+    // Kernel em lote contra a referência escalar em pares de todo o globo,
+    // metade deles a menos de ~0.1° do antípoda
+    void kernelContraHaversine() {
+        std::mt19937 gerador(15);
+        std::uniform_real_distribution<double> latitude(-90.0, 90.0);
+        std::uniform_real_distribution<double> longitude(-180.0, 180.0);
+        std::uniform_real_distribution<double> desvio(-0.1, 0.1);
+
+        constexpr int DESTINOS = 64;
+        for (int lote = 0; lote < 2000; ++lote) {
+            const double latitudeOrigem = latitude(gerador);
+            const double longitudeOrigem = longitude(gerador);
+            std::vector<double> latitudes, longitudes;
+            for (int j = 0; j < DESTINOS; ++j) {
+                if (j % 2 == 0) {
+                    latitudes.push_back(latitude(gerador));
+                    longitudes.push_back(longitude(gerador));
+                } else {
+                    latitudes.push_back(std::clamp(-latitudeOrigem + desvio(gerador), -90.0, 90.0));
+                    longitudes.push_back(longitudeOrigem + 180.0 + desvio(gerador));
+                }
+            }
+
+            CoordenadasEsfericas destinos;
+            destinos.definir(latitudes, longitudes);
+            const PontoEsferico origem = PontoEsferico::deGraus(latitudeOrigem, longitudeOrigem);
+            double saida[DESTINOS];
+            distanciasEmLoteKm(origem, destinos, 0, DESTINOS, saida);
+
+            for (int j = 0; j < DESTINOS; ++j) {
+                const double referencia =
+                    distanciaHaversineKm(latitudeOrigem, longitudeOrigem, latitudes[j], longitudes[j]);
+                const std::string contexto = "(" + std::to_string(latitudeOrigem) + ", " +
+                                             std::to_string(longitudeOrigem) + ") -> (" +
+                                             std::to_string(latitudes[j]) + ", " + std::to_string(longitudes[j]) +
+                                             "): " + std::to_string(saida[j] - referencia) + " km";
+                VERIFICAR_CONTEXTO(std::fabs(saida[j] - referencia) < 1e-10, contexto);
+                VERIFICAR_CONTEXTO(saida[j] == distanciaCordaKm(origem, destinos.ponto(j)), contexto);
+            }
+        }
+    }
+
+    // Caixa envolvente de 358° de longitude com pares a 2° pelo antimeridiano:
+    // a diagonal da caixa não limita o raio de busca
+    void grafoEsparsoNoAntimeridiano() {
+        teste::Instancia instancia;
+        for (double longitude : {-179.0, 179.0, 0.0, 90.0, -90.0}) {
+            instancia.locais.push_back({0.0, longitude, 1});
+        }
+        verificarGrafoEsparso(instancia, 4, "antimeridiano, k=4");
+        verificarGrafoEsparso(instancia, 2, "antimeridiano, k=2");
+    }
+
+    // Catálogos metropolitanos e espalhados pelo globo, com k de 1 a n
+    void grafoEsparsoAleatorio() {
+        std::mt19937 gerador(14);
+        std::uniform_real_distribution<double> latitude(-90.0, 90.0);
+        std::uniform_real_distribution<double> longitude(-180.0, 180.0);
+
+        for (int n : {1, 2, 5, 60}) {
+            const teste::Instancia metropolitana = teste::gerarInstancia(gerador, n);
+            teste::Instancia global;
+            for (int i = 0; i < n; ++i) global.locais.push_back({latitude(gerador), longitude(gerador), 1});
+
+            for (int k : {1, 4, 16, n}) {
+                const std::string tamanho = "n=" + std::to_string(n) + ", k=" + std::to_string(k);
+                verificarGrafoEsparso(metropolitana, k, "metropolitana, " + tamanho);
+                verificarGrafoEsparso(global, k, "global, " + tamanho);
+            }
+        }
+    }
+
+    // Tetos abaixo da tabela densa: a DP vira busca em feixe, que ora trunca
+    // camadas (heurística), ora não (ótimo comprovado)
+    void buscaEmFeixeComTeto() {
+        std::mt19937 gerador(20);
+        int comprovados = 0, semGarantia = 0;
+        for (int caso = 0; caso < 30; ++caso) {
+            const int n = 8 + caso % 3;
+            const teste::Instancia instancia = teste::gerarInstancia(gerador, n);
+            teste::escreverCsv(ARQUIVO, instancia);
+
+            OrienteeringProblemSolver solver;
+            teste::carregar(solver, ARQUIVO);
+
+            for (double orcamentoHoras : {0.3, 0.6, 1.0}) {
+                ParametrosViagem params{instancia.latitudeOrigem, instancia.longitudeOrigem,
+                                        orcamentoHoras, VELOCIDADE_KMH};
+                const teste::Referencia referencia(instancia, params);
+                const auto otimo = referencia.melhor();
+
+                for (std::size_t teto : {1024, 4096, 16384}) {
+                    OpcoesDP opcoes;
+                    opcoes.memoriaMaximaBytes = teto;
+                    const ResultadoSolucao resultado = solver.resolverProgramacaoDinamica(params, opcoes);
+                    const std::string contexto = descrever(n, orcamentoHoras, "feixe") + ", teto " +
+                                                 std::to_string(teto);
+
+                    VERIFICAR_CONTEXTO(resultado.pontuacaoTotal <= otimo.pontuacao, contexto);
+                    verificarRota(referencia, resultado, contexto);
+                    if (resultado.otimoComprovado) {
+                        ++comprovados;
+                        verificarOtimo(referencia, otimo, resultado, true, contexto);
+                    } else {
+                        ++semGarantia;
+                    }
+                }
+            }
+        }
+        // Os dois lados da garantia precisam ter sido exercitados
+        VERIFICAR(comprovados > 0);
+        VERIFICAR(semGarantia > 0);
+    }
+
+    // Prazo já esgotado: quem para não comprova o ótimo (quem termina antes
+    // de consultar o prazo precisa ter achado o ótimo), toda rota devolvida é
+    // viável e o GRASP ainda devolve a construção gulosa
+    void prazoEsgotado() {
+        std::mt19937 gerador(22);
+        const teste::Instancia instancia = teste::gerarInstancia(gerador, 14);
+        teste::escreverCsv(ARQUIVO, instancia);
+
+        OrienteeringProblemSolver solver;
+        teste::carregar(solver, ARQUIVO);
+
+        for (int modo = 0; modo < 2; ++modo) {
+            Interrupcao cancelada;
+            cancelada.cancelar();
+            const Interrupcao semPrazo = Interrupcao::emMilissegundos(0);
+
+            ParametrosViagem params{instancia.latitudeOrigem, instancia.longitudeOrigem, 1.0, VELOCIDADE_KMH};
+            params.interrupcao = modo == 0 ? &cancelada : &semPrazo;
+            const teste::Referencia referencia(instancia, params);
+            const auto otimo = referencia.melhor();
+
+            OpcoesDP simples;
+            simples.precisaoSimples = true;
+            OpcoesDP comTeto;
+            comTeto.memoriaMaximaBytes = 20000;
+            SLAConsulta sla;
+
+            const std::pair<const char*, ResultadoSolucao> resultados[] = {
+                {"dp", solver.resolverProgramacaoDinamica(params)},
+                {"dp float", solver.resolverProgramacaoDinamica(params, simples)},
+                {"feixe", solver.resolverProgramacaoDinamica(params, comTeto)},
+                {"dp esparsa", solver.resolverProgramacaoDinamicaEsparsa(params)},
+                {"bb", solver.resolverBranchAndBound(params)},
+                {"grasp", solver.resolverGRASP(params)},
+                {"guloso", solver.resolverGuloso(params)},
+                {"guloso-bl", solver.resolverGulosoComBuscaLocal(params)},
+                {"auto", solver.resolver(params, sla)},
+            };
+            for (const auto& [nome, resultado] : resultados) {
+                const std::string contexto = std::string(nome) + (modo == 0 ? ", cancelada" : ", prazo 0 ms");
+                VERIFICAR_CONTEXTO(!(resultado.interrompida && resultado.otimoComprovado), contexto);
+                if (resultado.otimoComprovado) {
+                    verificarOtimo(referencia, otimo, resultado, true, contexto);
+                } else {
+                    verificarRota(referencia, resultado, contexto);
+                }
+            }
+            VERIFICAR(resultados[0].second.interrompida);
+            VERIFICAR(resultados[5].second.interrompida && resultados[5].second.solucaoValida);
+        }
+    }
+
+    // O solver continua utilizável depois de movido (cache de origem e nomes)
+    void solverMovido() {
+        std::mt19937 gerador(99);
+        const teste::Instancia instancia = teste::gerarInstancia(gerador, 8);
+        teste::escreverCsv(ARQUIVO, instancia);
+
+        OrienteeringProblemSolver original;
+        teste::carregar(original, ARQUIVO);
+        ParametrosViagem params{instancia.latitudeOrigem, instancia.longitudeOrigem, 1.0, VELOCIDADE_KMH};
+        const ResultadoSolucao antes = original.resolverProgramacaoDinamica(params);
+
+        OrienteeringProblemSolver movido(std::move(original));
+        const ResultadoSolucao depois = movido.resolverProgramacaoDinamica(params);
+        VERIFICAR(depois.pontuacaoTotal == antes.pontuacaoTotal);
+        VERIFICAR(depois.rota == antes.rota);
+        VERIFICAR(movido.nomeLocal(0) == "Local 1");
+
+        OrienteeringProblemSolver atribuido;
+        atribuido = std::move(movido);
+        VERIFICAR(atribuido.resolverProgramacaoDinamica(params).rota == antes.rota);
+        VERIFICAR(atribuido.nomeLocal(7) == "Local 8");
+    }
+
+    // A tabela fica com a thread só dentro da retenção e do teto da consulta
+    void retencaoDaTabela() {
+        std::mt19937 gerador(5);
+        const teste::Instancia instancia = teste::gerarInstancia(gerador, 12);
+        teste::escreverCsv(ARQUIVO, instancia);
+
+        OrienteeringProblemSolver solver;
+        teste::carregar(solver, ARQUIVO);
+        ParametrosViagem params{instancia.latitudeOrigem, instancia.longitudeOrigem, 1.0, VELOCIDADE_KMH};
+        const EspacoTrabalho& espaco = EspacoTrabalho::daThread();
+
+        solver.resolverProgramacaoDinamica(params);
+        VERIFICAR(espaco.bytesTabelas() >= TabelaDP<double>::bytesNecessarios(12));
+
+        OpcoesDP semRetencao;
+        semRetencao.retencaoTabelaBytes = 0;
+        const ResultadoSolucao resultado = solver.resolverProgramacaoDinamica(params, semRetencao);
+        VERIFICAR(resultado.solucaoValida);
+        VERIFICAR(espaco.bytesTabelas() == 0);
+
+        // Teto menor que a tabela: busca em feixe, e a thread não guarda nada acima dele
+        solver.resolverProgramacaoDinamica(params);
+        OpcoesDP comTeto;
+        comTeto.memoriaMaximaBytes = TabelaDP<double>::bytesNecessarios(12) / 2;
+        solver.resolverProgramacaoDinamica(params, comTeto);
+        VERIFICAR(espaco.bytesTabelas() <= comTeto.memoriaMaximaBytes);
+    }
+}
+
+int main() {
+    compararComForcaBruta();
+    floatNoLimiteDoOrcamento();
+    solverMovido();
+    retencaoDaTabela();
+    buscaEmFeixeComTeto();
+    prazoEsgotado();
+    grafoEsparsoNoAntimeridiano();
+    grafoEsparsoAleatorio();
+    kernelContraHaversine();
+    return teste::resultado("teste_dp");
+}
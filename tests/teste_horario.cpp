@@ -0,0 +1,160 @@
+#include "ApoioTestes.h"
+#include <cmath>
+#include <string>
+
+// MODO HORÁRIO: PERFIL DE VELOCIDADE E JANELAS CONTRA A FORÇA BRUTA
+//
+// O perfil precisa respeitar FIFO (sair mais tarde nunca chega mais cedo),
+// que é o que deixa a DP guardar só o horário mais cedo por estado. A DP e
+// o despacho "otima" precisam achar a pontuação máxima da força bruta, e
+// toda rota devolvida precisa ser viável quando percorrida trecho a trecho.
+// Os solvers de velocidade constante recusam o modo horário.
+
+namespace {
+    const std::string ARQUIVO = "teste_horario.csv";
+    constexpr double VELOCIDADE_KMH = 25.0;
+
+    // 24 faixas de 1 h com fatores entre 0.3 (pico) e 1.5
+    PerfilVelocidade sortearPerfil(std::mt19937& gerador) {
+        std::uniform_real_distribution<double> fator(0.3, 1.5);
+        std::vector<double> fatores(24);
+        for (double& valor : fatores) valor = fator(gerador);
+        return PerfilVelocidade(1.0, fatores);
+    }
+
+    std::string descrever(const char* solver, int caso, double orcamentoHoras) {
+        return std::string(solver) + ", caso " + std::to_string(caso) + ", orcamento=" +
+               std::to_string(orcamentoHoras) + " h";
+    }
+
+    void verificarRota(const teste::Referencia& referencia, const ResultadoSolucao& resultado,
+                       const std::string& contexto) {
+        if (!resultado.solucaoValida) return;
+        const auto avaliacao = referencia.avaliar(resultado.rota);
+        VERIFICAR_CONTEXTO(avaliacao.viavel, contexto);
+        VERIFICAR_CONTEXTO(avaliacao.pontuacao == resultado.pontuacaoTotal, contexto);
+    }
+
+    void verificarOtimo(const teste::Referencia& referencia, int pontuacaoOtima, const ResultadoSolucao& resultado,
+                        const std::string& contexto) {
+        VERIFICAR_CONTEXTO(resultado.pontuacaoTotal == pontuacaoOtima, contexto + ": pontuacao " +
+                           std::to_string(resultado.pontuacaoTotal) + ", esperada " + std::to_string(pontuacaoOtima));
+        verificarRota(referencia, resultado, contexto);
+    }
+
+    void perfilRespeitaFifo() {
+        std::mt19937 gerador(31);
+        std::uniform_real_distribution<double> horario(0.0, 48.0);
+        std::uniform_real_distribution<double> atraso(0.0, 2.0);
+        std::uniform_real_distribution<double> distancia(0.0, 60.0);
+
+        for (int perfil = 0; perfil < 20; ++perfil) {
+            const PerfilVelocidade velocidade = sortearPerfil(gerador);
+            for (int amostra = 0; amostra < 2000; ++amostra) {
+                const double cedo = horario(gerador);
+                const double tarde = cedo + atraso(gerador);
+                const double km = distancia(gerador);
+                const double chegadaCedo = velocidade.chegada(cedo, km, VELOCIDADE_KMH, 0);
+                const double chegadaTarde = velocidade.chegada(tarde, km, VELOCIDADE_KMH, 0);
+                VERIFICAR_CONTEXTO(chegadaCedo <= chegadaTarde + 1e-12,
+                                   "partidas " + std::to_string(cedo) + " e " + std::to_string(tarde));
+                VERIFICAR(chegadaCedo >= cedo);
+            }
+        }
+
+        // Fator 1 em todas as faixas é a velocidade constante
+        const PerfilVelocidade constante(1.0, std::vector<double>(24, 1.0));
+        VERIFICAR(std::fabs(constante.chegada(7.5, 50.0, VELOCIDADE_KMH, 0) - (7.5 + 2.0)) < 1e-12);
+    }
+
+    // comPerfil, comJanelas: qual parte do modo horário cada rodada exercita
+    void compararComForcaBruta(bool comPerfil, bool comJanelas, unsigned semente) {
+        std::mt19937 gerador(semente);
+        std::uniform_real_distribution<double> horaPartida(6.0, 11.0);
+
+        for (int caso = 0; caso < 50; ++caso) {
+            teste::Instancia instancia = teste::gerarInstancia(gerador, 2 + caso % 7);
+            if (comJanelas) teste::sortearJanelas(gerador, instancia);
+            teste::escreverCsv(ARQUIVO, instancia, comJanelas);
+
+            OrienteeringProblemSolver solver;
+            teste::carregar(solver, ARQUIVO);
+            const PerfilVelocidade perfil = comPerfil ? sortearPerfil(gerador) : PerfilVelocidade();
+            solver.definirPerfilVelocidade(perfil);
+
+            const double partida = horaPartida(gerador);
+            for (double orcamentoHoras : {0.5, 1.2, 2.5, 5.0}) {
+                ParametrosViagem params{instancia.latitudeOrigem, instancia.longitudeOrigem,
+                                        orcamentoHoras, VELOCIDADE_KMH};
+                params.horaPartida = partida;
+                const teste::Referencia referencia(instancia, params, perfil);
+                const int otimo = referencia.melhor().pontuacao;
+
+                OpcoesDP simples;
+                simples.precisaoSimples = true;
+                SLAConsulta sla;
+                sla.latenciaMaximaMs = 0;
+
+                verificarOtimo(referencia, otimo, solver.resolverProgramacaoDinamica(params),
+                               descrever("dp", caso, orcamentoHoras));
+                verificarRota(referencia, solver.resolverProgramacaoDinamica(params, simples),
+                              descrever("dp float", caso, orcamentoHoras));
+                verificarOtimo(referencia, otimo, solver.resolver(params, sla),
+                               descrever("auto", caso, orcamentoHoras));
+                verificarRota(referencia, solver.resolverGuloso(params), descrever("guloso", caso, orcamentoHoras));
+                verificarRota(referencia, solver.resolverGulosoComBuscaLocal(params),
+                              descrever("guloso-bl", caso, orcamentoHoras));
+            }
+        }
+    }
+
+    // DP esparsa, branch-and-bound, GRASP e fronteira só conhecem distância
+    void solversDeVelocidadeConstanteRecusam() {
+        std::mt19937 gerador(3);
+        teste::Instancia instancia = teste::gerarInstancia(gerador, 6);
+        teste::escreverCsv(ARQUIVO, instancia);
+
+        OrienteeringProblemSolver solver;
+        teste::carregar(solver, ARQUIVO);
+        ParametrosViagem params{instancia.latitudeOrigem, instancia.longitudeOrigem, 3.0, VELOCIDADE_KMH};
+        params.horaPartida = 8.0;
+
+        VERIFICAR(solver.resolverBranchAndBound(params).solucaoValida);
+        VERIFICAR(solver.suportaAlgoritmo(Algoritmo::BranchAndBound));
+
+        // Perfil
+        solver.definirPerfilVelocidade(sortearPerfil(gerador));
+        VERIFICAR(!solver.resolverBranchAndBound(params).solucaoValida);
+        VERIFICAR(!solver.resolverProgramacaoDinamicaEsparsa(params).solucaoValida);
+        VERIFICAR(!solver.resolverGRASP(params).solucaoValida);
+        VERIFICAR(solver.construirFronteiraPareto(instancia.latitudeOrigem, instancia.longitudeOrigem).pontos.empty());
+        VERIFICAR(!solver.suportaAlgoritmo(Algoritmo::BranchAndBound));
+        VERIFICAR(!solver.suportaAlgoritmo(Algoritmo::ProgramacaoDinamicaEsparsa));
+        VERIFICAR(!solver.suportaAlgoritmo(Algoritmo::GRASP));
+        VERIFICAR(solver.suportaAlgoritmo(Algoritmo::ProgramacaoDinamica));
+        VERIFICAR(solver.suportaAlgoritmo(Algoritmo::Automatico));
+
+        // Janelas, sem perfil
+        teste::sortearJanelas(gerador, instancia);
+        teste::escreverCsv(ARQUIVO, instancia, true);
+        OrienteeringProblemSolver comJanelas;
+        teste::carregar(comJanelas, ARQUIVO);
+        VERIFICAR(!comJanelas.resolverBranchAndBound(params).solucaoValida);
+        VERIFICAR(!comJanelas.suportaAlgoritmo(Algoritmo::GRASP));
+
+        DecisaoDespacho decisao;
+        SLAConsulta sla;
+        sla.latenciaMaximaMs = 0;
+        comJanelas.resolver(params, sla, &decisao);
+        VERIFICAR(comJanelas.suportaAlgoritmo(decisao.algoritmo));
+    }
+}
+
+int main() {
+    perfilRespeitaFifo();
+    compararComForcaBruta(true, false, 11);
+    compararComForcaBruta(false, true, 12);
+    compararComForcaBruta(true, true, 13);
+    solversDeVelocidadeConstanteRecusam();
+    return teste::resultado("teste_horario");
+}
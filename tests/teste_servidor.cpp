@@ -0,0 +1,84 @@
+#include "ApoioTestes.h"
+#include "Servidor.h"
+#include <memory>
+#include <string>
+
+// PROTOCOLO DO SERVIDOR
+//
+// ServidorSolver::responder sem socket: consultas válidas, campos
+// inválidos (inclusive números não finitos e fora dos limites), algoritmos
+// recusados no modo horário e os campos da decisão do despacho "auto".
+
+namespace {
+    const std::string ARQUIVO = "teste_servidor.csv";
+    const std::string CONSULTA = "\"latitude\":-22.95,\"longitude\":-43.22,\"orcamentoHoras\":1.5,\"velocidadeKmh\":30";
+
+    bool contem(const std::string& resposta, const std::string& trecho) {
+        return resposta.find(trecho) != std::string::npos;
+    }
+
+    std::unique_ptr<OrienteeringProblemSolver> catalogo(unsigned semente, bool comHorario) {
+        std::mt19937 gerador(semente);
+        teste::Instancia instancia = teste::gerarInstancia(gerador, 10);
+        if (comHorario) teste::sortearJanelas(gerador, instancia);
+        teste::escreverCsv(ARQUIVO, instancia, comHorario);
+
+        auto solver = std::make_unique<OrienteeringProblemSolver>();
+        teste::carregar(*solver, ARQUIVO);
+        return solver;
+    }
+
+    void verificarErro(const ServidorSolver& servidor, const std::string& requisicao, const std::string& trecho) {
+        const std::string resposta = servidor.responder(requisicao);
+        VERIFICAR_CONTEXTO(contem(resposta, "\"erro\":") && contem(resposta, trecho), requisicao + " -> " + resposta);
+        VERIFICAR_CONTEXTO(!contem(resposta, "\"valida\""), requisicao + " -> " + resposta);
+    }
+}
+
+int main() {
+    ServidorSolver servidor(1);
+    servidor.adicionarCatalogo("plano", catalogo(70, false));
+    servidor.adicionarCatalogo("janelas", catalogo(71, true));
+
+    // Consultas válidas
+    const std::string dp = servidor.responder("{\"id\":7," + CONSULTA + ",\"algoritmo\":\"dp\"}");
+    VERIFICAR_CONTEXTO(contem(dp, "{\"id\":7,\"valida\":true") && contem(dp, "\"otimo\":true"), dp);
+
+    const std::string janelas = servidor.responder("{\"id\":\"a\"," + CONSULTA +
+                                                   ",\"algoritmo\":\"dp\",\"catalogo\":\"janelas\",\"horaPartida\":8.5}");
+    VERIFICAR_CONTEXTO(contem(janelas, "{\"id\":\"a\",\"valida\":"), janelas);
+
+    const std::string automatico = servidor.responder("{\"id\":8," + CONSULTA +
+                                                      ",\"algoritmo\":\"auto\",\"prazoMs\":500,\"memoriaDPMB\":64}");
+    VERIFICAR_CONTEXTO(contem(automatico, "\"algoritmo\":") && contem(automatico, "\"estimadoMs\":") &&
+                       contem(automatico, "\"estadosEstimados\":") && contem(automatico, "\"metaAtendida\":"),
+                       automatico);
+
+    // Números que não são JSON ou que estourariam as conversões
+    verificarErro(servidor, "{\"id\":1,\"latitude\":nan,\"longitude\":-43.22,\"orcamentoHoras\":1,\"velocidadeKmh\":30}",
+                  "latitude");
+    verificarErro(servidor, "{\"id\":1,\"latitude\":-22.95,\"longitude\":-43.22,\"orcamentoHoras\":inf,\"velocidadeKmh\":30}",
+                  "orcamentoHoras");
+    verificarErro(servidor, "{\"id\":1," + CONSULTA + ",\"prazoMs\":1e400}", "prazoMs");
+    verificarErro(servidor, "{\"id\":1," + CONSULTA + ",\"prazoMs\":-infinity}", "prazoMs");
+    verificarErro(servidor, "{\"id\":1," + CONSULTA + ",\"prazoMs\":1e300}", "prazoMs");
+    verificarErro(servidor, "{\"id\":1," + CONSULTA + ",\"algoritmo\":\"dp\",\"memoriaDPMB\":1e30}", "memoriaDPMB");
+    verificarErro(servidor, "{\"id\":1," + CONSULTA + ",\"memoriaDPMB\":-1}", "invalidos");
+
+    // Campos e nomes inválidos
+    verificarErro(servidor, "{\"id\":1,\"latitude\":-22.95}", "obrigatorios");
+    verificarErro(servidor, "{\"id\":1," + CONSULTA + ",\"algoritmo\":\"simplex\"}", "simplex");
+    verificarErro(servidor, "{\"id\":1," + CONSULTA + ",\"catalogo\":\"outro\"}", "outro");
+    verificarErro(servidor, "{\"id\":1," + CONSULTA + ",\"algoritmo\":3}", "algoritmo");
+    verificarErro(servidor, "{\"id\":1," + CONSULTA, "JSON invalido");
+
+    // Solvers de velocidade constante no catálogo com janelas
+    for (const char* algoritmo : {"bb", "dp-esparsa", "grasp"}) {
+        verificarErro(servidor, "{\"id\":1," + CONSULTA + ",\"catalogo\":\"janelas\",\"algoritmo\":\"" +
+                      algoritmo + "\"}", algoritmo);
+    }
+    const std::string bbPlano = servidor.responder("{\"id\":2," + CONSULTA + ",\"algoritmo\":\"bb\"}");
+    VERIFICAR_CONTEXTO(contem(bbPlano, "\"valida\":true"), bbPlano);
+
+    return teste::resultado("teste_servidor");
+}
@@ -0,0 +1,153 @@
+#include "ApoioTestes.h"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+// SNAPSHOT BINÁRIO
+//
+// Gravar e carregar precisa devolver o mesmo catálogo que o CSV (ids,
+// nomes, coordenadas, pontuações e horários) e as mesmas rotas. Snapshots
+// truncados ou corrompidos são recusados com exceção, a gravação não deixa
+// o temporário para trás e regravar o arquivo não afeta quem já o mapeou.
+
+namespace {
+    const std::string ARQUIVO_CSV = "teste_snapshot.csv";
+    const std::string ARQUIVO_SNAPSHOT = "teste_snapshot.grafo";
+
+    bool existe(const std::string& caminho) {
+        return std::ifstream(caminho).good();
+    }
+
+    bool recusado(const std::string& caminho) {
+        OrienteeringProblemSolver solver;
+        solver.definirSilencioso(true);
+        try {
+            solver.carregarSnapshot(caminho);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    }
+
+    void copiarTruncado(const std::string& origem, const std::string& destino, std::size_t bytes) {
+        std::ifstream entrada(origem, std::ios::binary);
+        std::string conteudo((std::istreambuf_iterator<char>(entrada)), std::istreambuf_iterator<char>());
+        conteudo.resize(std::min(bytes, conteudo.size()));
+        std::ofstream(destino, std::ios::binary) << conteudo;
+    }
+
+    void idaEVolta(bool comHorario) {
+        std::mt19937 gerador(comHorario ? 41 : 40);
+        teste::Instancia instancia = teste::gerarInstancia(gerador, 14);
+        if (comHorario) teste::sortearJanelas(gerador, instancia);
+        teste::escreverCsv(ARQUIVO_CSV, instancia, comHorario);
+
+        OrienteeringProblemSolver doCsv;
+        teste::carregar(doCsv, ARQUIVO_CSV);
+        doCsv.salvarSnapshot(ARQUIVO_SNAPSHOT);
+        VERIFICAR(existe(ARQUIVO_SNAPSHOT));
+        VERIFICAR(!existe(ARQUIVO_SNAPSHOT + ".tmp"));
+
+        OrienteeringProblemSolver doSnapshot;
+        doSnapshot.definirSilencioso(true);
+        doSnapshot.carregarSnapshot(ARQUIVO_SNAPSHOT);
+
+        VERIFICAR(doSnapshot.quantidadeLocais() == doCsv.quantidadeLocais());
+        for (int i = 0; i < doCsv.quantidadeLocais() && i < doSnapshot.quantidadeLocais(); ++i) {
+            const Local& a = doCsv.obterLocal(i);
+            const Local& b = doSnapshot.obterLocal(i);
+            const std::string contexto = "local " + std::to_string(i);
+            VERIFICAR_CONTEXTO(a.id == b.id && a.pontuacao == b.pontuacao, contexto);
+            VERIFICAR_CONTEXTO(a.latitude == b.latitude && a.longitude == b.longitude, contexto);
+            VERIFICAR_CONTEXTO(a.duracaoVisitaHoras == b.duracaoVisitaHoras && a.aberturaHoras == b.aberturaHoras &&
+                               a.fechamentoHoras == b.fechamentoHoras, contexto);
+            VERIFICAR_CONTEXTO(doCsv.nomeLocal(i) == doSnapshot.nomeLocal(i), contexto);
+            VERIFICAR_CONTEXTO(doSnapshot.nomeLocal(i) == "Local " + std::to_string(i + 1), contexto);
+        }
+
+        for (double orcamentoHoras : {0.4, 1.0, 2.5}) {
+            ParametrosViagem params{instancia.latitudeOrigem, instancia.longitudeOrigem, orcamentoHoras, 30.0};
+            params.horaPartida = 8.5;
+            const ResultadoSolucao a = doCsv.resolverProgramacaoDinamica(params);
+            const ResultadoSolucao b = doSnapshot.resolverProgramacaoDinamica(params);
+            VERIFICAR(a.pontuacaoTotal == b.pontuacaoTotal);
+            VERIFICAR(a.rota == b.rota);
+            VERIFICAR(a.custoKm == b.custoKm);
+            VERIFICAR(doCsv.resolverGuloso(params).rota == doSnapshot.resolverGuloso(params).rota);
+        }
+    }
+
+    void snapshotsInvalidosSaoRecusados() {
+        std::mt19937 gerador(50);
+        teste::escreverCsv(ARQUIVO_CSV, teste::gerarInstancia(gerador, 9));
+        OrienteeringProblemSolver solver;
+        teste::carregar(solver, ARQUIVO_CSV);
+        solver.salvarSnapshot(ARQUIVO_SNAPSHOT);
+
+        const std::string invalido = "teste_snapshot_invalido.grafo";
+        VERIFICAR(recusado("teste_snapshot_inexistente.grafo"));
+
+        copiarTruncado(ARQUIVO_SNAPSHOT, invalido, 0);
+        VERIFICAR(recusado(invalido));
+        copiarTruncado(ARQUIVO_SNAPSHOT, invalido, 16);
+        VERIFICAR(recusado(invalido));
+
+        std::ifstream entrada(ARQUIVO_SNAPSHOT, std::ios::binary);
+        const std::string completo((std::istreambuf_iterator<char>(entrada)), std::istreambuf_iterator<char>());
+        copiarTruncado(ARQUIVO_SNAPSHOT, invalido, completo.size() - 8);
+        VERIFICAR(recusado(invalido));
+
+        std::string corrompido = completo;
+        corrompido[0] ^= 0x5A;  // Assinatura
+        std::ofstream(invalido, std::ios::binary) << corrompido;
+        VERIFICAR(recusado(invalido));
+
+        std::remove(invalido.c_str());
+    }
+
+    // Quem mapeou o snapshot continua com a versão antiga depois da regravação
+    void regravarComSnapshotMapeado() {
+        std::mt19937 gerador(60);
+        const teste::Instancia pequena = teste::gerarInstancia(gerador, 10);
+        teste::escreverCsv(ARQUIVO_CSV, pequena);
+        OrienteeringProblemSolver original;
+        teste::carregar(original, ARQUIVO_CSV);
+        original.salvarSnapshot(ARQUIVO_SNAPSHOT);
+
+        OrienteeringProblemSolver mapeado;
+        mapeado.definirSilencioso(true);
+        mapeado.carregarSnapshot(ARQUIVO_SNAPSHOT);
+        ParametrosViagem params{pequena.latitudeOrigem, pequena.longitudeOrigem, 1.5, 30.0};
+        const ResultadoSolucao antes = mapeado.resolverProgramacaoDinamica(params);
+
+        // Catálogo maior no mesmo caminho: o arquivo antigo não pode encolher por baixo do mapeamento
+        teste::escreverCsv(ARQUIVO_CSV, teste::gerarInstancia(gerador, 200));
+        OrienteeringProblemSolver maior;
+        teste::carregar(maior, ARQUIVO_CSV);
+        maior.salvarSnapshot(ARQUIVO_SNAPSHOT);
+        teste::escreverCsv(ARQUIVO_CSV, teste::gerarInstancia(gerador, 3));
+        OrienteeringProblemSolver menor;
+        teste::carregar(menor, ARQUIVO_CSV);
+        menor.salvarSnapshot(ARQUIVO_SNAPSHOT);
+
+        const ResultadoSolucao depois = mapeado.resolverProgramacaoDinamica(params);
+        VERIFICAR(mapeado.quantidadeLocais() == 10);
+        VERIFICAR(depois.rota == antes.rota);
+        VERIFICAR(mapeado.nomeLocal(9) == "Local 10");
+
+        OrienteeringProblemSolver recarregado;
+        recarregado.definirSilencioso(true);
+        recarregado.carregarSnapshot(ARQUIVO_SNAPSHOT);
+        VERIFICAR(recarregado.quantidadeLocais() == 3);
+    }
+}
+
+int main() {
+    idaEVolta(false);
+    idaEVolta(true);
+    snapshotsInvalidosSaoRecusados();
+    regravarComSnapshotMapeado();
+    std::remove(ARQUIVO_SNAPSHOT.c_str());
+    return teste::resultado("teste_snapshot");
+}